@@ -0,0 +1,207 @@
+#include "ProgramGenerator.h"
+#include "Parser/Scanner.h"
+#include "Parser.h"
+#include "Context.h"
+#include "Misc.h"
+#include "Semant/TypeDriver.h"
+#include "CodeGen/CodeGenDriver.h"
+#include "benchmark/benchmark.h"
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace mcool::benchmarks {
+namespace {
+struct Axis {
+  const char* name;
+  unsigned ProgramShape::*field;
+  int64_t minValue;
+  int64_t maxValue;
+};
+
+// every axis is scaled separately while the others keep their defaults
+const std::vector<Axis> axes{
+    {"classes", &ProgramShape::numClasses, 8, 256},
+    {"inheritance_depth", &ProgramShape::inheritanceDepth, 1, 64},
+    {"methods_per_class", &ProgramShape::methodsPerClass, 2, 64},
+    {"expression_depth", &ProgramShape::expressionDepth, 2, 64},
+    {"statements_per_method", &ProgramShape::statementsPerMethod, 2, 64},
+};
+
+std::string getProgram(const Axis& axis, int64_t value) {
+  ProgramShape shape{};
+  if (axis.field == &ProgramShape::inheritanceDepth) {
+    // chains as long as the axis needs enough classes to be built
+    shape.numClasses = std::max<unsigned>(shape.numClasses, value);
+  }
+  shape.*(axis.field) = static_cast<unsigned>(value);
+  return generateProgram(shape);
+}
+
+std::string inputFileName{"benchmark.cl"};
+
+struct ParsedProgram {
+  std::unique_ptr<Context> context{std::make_unique<Context>()};
+  AstTree astTree{};
+};
+
+std::unique_ptr<ParsedProgram> parse(const std::string& program) {
+  auto parsedProgram = std::make_unique<ParsedProgram>();
+  std::istringstream stream(program);
+  Scanner scanner(true);
+  Parser parser(scanner, parsedProgram->astTree, parsedProgram->context->getMemoryManager());
+  scanner.set(&stream, &inputFileName);
+  if (parser.parse() != 0) {
+    return nullptr;
+  }
+  return parsedProgram;
+}
+
+std::unique_ptr<ParsedProgram> parseAndCheck(const std::string& program, misc::Config& config) {
+  auto parsedProgram = parse(program);
+  if (parsedProgram == nullptr) {
+    return nullptr;
+  }
+  AstTree::addBuildinClasses(parsedProgram->astTree.get(), parsedProgram->context.get());
+  TypeDriver typeDriver(*parsedProgram->context, config);
+  if (not typeDriver.run(parsedProgram->astTree)) {
+    return nullptr;
+  }
+  return parsedProgram;
+}
+
+misc::Config getConfig() {
+  misc::Config config{};
+  config.inputFiles.push_back(inputFileName);
+  config.outputFile = (std::filesystem::temp_directory_path() / "mcool-benchmark").string();
+  return config;
+}
+
+// counts bytes of source code per second and lets the library fit the growth of the time
+// per iteration, e.g. O(N^2) points at super-linear behavior along the axis
+void setCounters(benchmark::State& state, const std::string& program) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * program.size()));
+  state.SetComplexityN(state.range(0));
+}
+
+void scanProgram(benchmark::State& state, const Axis& axis) {
+  auto program = getProgram(axis, state.range(0));
+  for (auto _ : state) {
+    std::istringstream stream(program);
+    Scanner scanner(true);
+    scanner.set(&stream, &inputFileName);
+    size_t numTokens{0};
+    while (scanner.get_next_token().kind() != Parser::symbol_kind_type::S_YYEOF) {
+      ++numTokens;
+    }
+    benchmark::DoNotOptimize(numTokens);
+  }
+  setCounters(state, program);
+}
+
+void parseProgram(benchmark::State& state, const Axis& axis) {
+  auto program = getProgram(axis, state.range(0));
+  for (auto _ : state) {
+    auto parsedProgram = parse(program);
+    if (parsedProgram == nullptr) {
+      state.SkipWithError("parsing failed");
+      break;
+    }
+    benchmark::DoNotOptimize(parsedProgram->astTree.get());
+  }
+  setCounters(state, program);
+}
+
+// parsing and releasing the ast are excluded from the measured time
+void checkProgram(benchmark::State& state, const Axis& axis) {
+  auto program = getProgram(axis, state.range(0));
+  auto config = getConfig();
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto parsedProgram = parse(program);
+    if (parsedProgram == nullptr) {
+      state.SkipWithError("parsing failed");
+      break;
+    }
+    AstTree::addBuildinClasses(parsedProgram->astTree.get(), parsedProgram->context.get());
+    state.ResumeTiming();
+
+    TypeDriver typeDriver(*parsedProgram->context, config);
+    bool isOk = typeDriver.run(parsedProgram->astTree);
+
+    state.PauseTiming();
+    parsedProgram.reset();
+    state.ResumeTiming();
+    if (not isOk) {
+      state.SkipWithError("type checking failed");
+      break;
+    }
+  }
+  setCounters(state, program);
+}
+
+// includes the emission of an object file into the temporary directory
+void generateCode(benchmark::State& state, const Axis& axis) {
+  auto program = getProgram(axis, state.range(0));
+  auto config = getConfig();
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto parsedProgram = parseAndCheck(program, config);
+    if (parsedProgram == nullptr) {
+      state.SkipWithError("front-end failed");
+      break;
+    }
+    state.ResumeTiming();
+
+    bool isOk{false};
+    {
+      codegen::CodeGenDriver codeGenDriver(*parsedProgram->context, config);
+      isOk = codeGenDriver.run(parsedProgram->astTree);
+    }
+
+    state.PauseTiming();
+    parsedProgram.reset();
+    state.ResumeTiming();
+    if (not isOk) {
+      state.SkipWithError("code generation failed");
+      break;
+    }
+  }
+  setCounters(state, program);
+}
+
+void registerBenchmarks() {
+  using Stage = std::pair<const char*, void (*)(benchmark::State&, const Axis&)>;
+  const std::vector<Stage> stages{
+      {"Scanner", scanProgram},
+      {"Parser", parseProgram},
+      {"TypeDriver", checkProgram},
+      {"CodeGenDriver", generateCode},
+  };
+  for (auto& [stageName, function] : stages) {
+    for (auto& axis : axes) {
+      auto name = std::string(stageName) + "/" + axis.name;
+      benchmark::RegisterBenchmark(name.c_str(), function, axis)
+          ->RangeMultiplier(2)
+          ->Range(axis.minValue, axis.maxValue)
+          ->Unit(benchmark::kMicrosecond)
+          ->Complexity();
+    }
+  }
+}
+} // namespace
+} // namespace mcool::benchmarks
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  mcool::benchmarks::registerBenchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
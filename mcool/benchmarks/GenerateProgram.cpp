@@ -0,0 +1,39 @@
+#include "ProgramGenerator.h"
+#include "CLI/App.hpp"
+#include "CLI/Formatter.hpp"
+#include "CLI/Config.hpp"
+#include <fstream>
+#include <iostream>
+
+// writes a synthetic program, e.g. to profile the compiler itself with `--time-phases`
+int main(int argc, char* argv[]) {
+  mcool::benchmarks::ProgramShape shape{};
+  std::string outputFile{};
+
+  CLI::App cmd{"generator of synthetic cool programs"};
+  cmd.add_option("--classes", shape.numClasses, "number of classes");
+  cmd.add_option("--inheritance-depth", shape.inheritanceDepth, "length of inheritance chains");
+  cmd.add_option("--methods", shape.methodsPerClass, "methods per class");
+  cmd.add_option("--expression-depth", shape.expressionDepth, "nesting of expressions");
+  cmd.add_option("--statements", shape.statementsPerMethod, "expressions per method body");
+  cmd.add_option("-o,--output", outputFile, "output file; stdout by default");
+  try {
+    cmd.parse(argc, argv);
+  } catch (const CLI::ParseError& err) {
+    return cmd.exit(err);
+  }
+
+  auto program = mcool::benchmarks::generateProgram(shape);
+  if (outputFile.empty()) {
+    std::cout << program;
+    return 0;
+  }
+
+  std::ofstream stream(outputFile);
+  if (stream.fail()) {
+    std::cerr << "cannot open file: " << outputFile << std::endl;
+    return -1;
+  }
+  stream << program;
+  return 0;
+}
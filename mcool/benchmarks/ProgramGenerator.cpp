@@ -0,0 +1,121 @@
+#include "ProgramGenerator.h"
+#include <algorithm>
+#include <sstream>
+
+namespace mcool::benchmarks {
+namespace {
+class Generator {
+  public:
+  explicit Generator(const ProgramShape& programShape) : shape(programShape) {
+    shape.numClasses = std::max(shape.numClasses, 1u);
+    shape.inheritanceDepth = std::max(shape.inheritanceDepth, 1u);
+    shape.methodsPerClass = std::max(shape.methodsPerClass, 1u);
+  }
+
+  std::string run() {
+    for (unsigned i = 0; i < shape.numClasses; ++i) {
+      genClass(i);
+    }
+    genMain();
+    return stream.str();
+  }
+
+  private:
+  // every method is called, so that code is generated for all of them, but only `C0.m0`
+  // runs; the calls of other methods may take time exponential in the number of methods
+  void genMain() {
+    stream << "class Main inherits IO {\n"
+           << "  n: Int;\n"
+           << "  main(): Object {{\n"
+           << "    let c: C0 <- new C0 in out_int(c.m0(1, 2));\n"
+           << "    if 1 <= n then {\n";
+    for (unsigned classIndex = 0; classIndex < shape.numClasses; ++classIndex) {
+      stream << "      let c: C" << classIndex << " <- new C" << classIndex << " in {";
+      for (unsigned method = 0; method < shape.methodsPerClass; ++method) {
+        stream << " c.m" << method << "(1, 2);";
+      }
+      stream << " };\n";
+    }
+    stream << "    } else 0 fi;\n"
+           << "  }};\n"
+           << "};\n";
+  }
+
+  void genClass(unsigned classIndex) {
+    stream << "class C" << classIndex;
+    if (classIndex % shape.inheritanceDepth != 0) {
+      stream << " inherits C" << (classIndex - 1);
+    }
+    stream << " {\n";
+    stream << "  a" << classIndex << ": Int <- " << classIndex << ";\n";
+    for (unsigned method = 0; method < shape.methodsPerClass; ++method) {
+      genMethod(classIndex, method);
+    }
+    stream << "};\n\n";
+  }
+
+  void genMethod(unsigned classIndex, unsigned method) {
+    stream << "  m" << method << "(x: Int, y: Int): Int {\n    {\n";
+    for (unsigned statement = 0; statement < shape.statementsPerMethod; ++statement) {
+      stream << "      ";
+      genExpression(classIndex, method, method + statement, shape.expressionDepth);
+      stream << ";\n";
+    }
+    stream << "      x;\n    }\n  };\n";
+  }
+
+  // every level has a single nested expression and leaves otherwise. Methods dispatch to
+  // methods with lower numbers only, thus no call recurses
+  void genExpression(unsigned classIndex, unsigned method, unsigned seed, unsigned depth) {
+    if (depth == 0) {
+      if (seed % 2 == 0) {
+        stream << "x";
+      } else {
+        stream << "a" << getChainRoot(classIndex);
+      }
+      return;
+    }
+
+    auto next = [&]() { genExpression(classIndex, method, seed + 1, depth - 1); };
+    // arithmetic is nested through `let`, parentheses only enclose arithmetic in COOL
+    auto kind = (seed + 2 * depth) % 4;
+    if ((kind == 3) && (method == 0)) {
+      kind = 1;
+    }
+    switch (kind) {
+    case 0:
+      stream << "if x < y then ";
+      next();
+      stream << " else y fi";
+      break;
+    case 1:
+      stream << "let t" << depth << ": Int <- ";
+      next();
+      stream << " in t" << depth << " + y * " << depth;
+      break;
+    case 2:
+      stream << "{ y; ";
+      next();
+      stream << "; }";
+      break;
+    default:
+      stream << "self.m" << (seed % method) << "(";
+      next();
+      stream << ", y)";
+      break;
+    }
+  }
+
+  // members of a class are visible in its descendants, thus the first class of a chain
+  // defines the member every class of the chain may use
+  unsigned getChainRoot(unsigned classIndex) {
+    return classIndex - classIndex % shape.inheritanceDepth;
+  }
+
+  ProgramShape shape;
+  std::ostringstream stream{};
+};
+} // namespace
+
+std::string generateProgram(const ProgramShape& shape) { return Generator(shape).run(); }
+} // namespace mcool::benchmarks
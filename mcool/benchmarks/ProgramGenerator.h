@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+namespace mcool::benchmarks {
+// Axes along which synthetic programs grow. Classes form chains of `inheritanceDepth`
+// classes, every class overrides all methods of its parent. A method body is a block of
+// `statementsPerMethod` expressions, each nested `expressionDepth` levels deep, thus the size
+// of a program is linear in every axis.
+struct ProgramShape {
+  unsigned numClasses{16};
+  unsigned inheritanceDepth{4};
+  unsigned methodsPerClass{8};
+  unsigned expressionDepth{4};
+  unsigned statementsPerMethod{4};
+};
+
+// generates a well-typed program with a `Main` class
+std::string generateProgram(const ProgramShape& shape);
+} // namespace mcool::benchmarks
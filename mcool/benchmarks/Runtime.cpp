@@ -0,0 +1,448 @@
+#include "CLI/App.hpp"
+#include "CLI/Formatter.hpp"
+#include "CLI/Config.hpp"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace mcool::benchmarks {
+namespace {
+namespace fs = std::filesystem;
+
+struct Options {
+  std::string compiler{MCOOL_COMPILER_PATH};
+  std::string programsDir{MCOOL_BENCHMARK_PROGRAMS_DIR};
+  std::string baselineFile{MCOOL_BENCHMARK_BASELINE};
+  std::string outputFile{};
+  std::string workDir{(fs::temp_directory_path() / "mcool-runtime-benchmarks").string()};
+  std::string linker{"cc -no-pie"};
+  std::string filter{};
+  unsigned numRuns{5};
+  double threshold{0.2};
+};
+
+struct Configuration {
+  const char* name;
+  std::vector<std::string> flags;
+};
+
+const std::vector<Configuration> configurations{
+    {"O0", {"-O0"}},
+    {"O1", {"-O1"}},
+    {"O2", {"-O2"}},
+    {"O3", {"-O3"}},
+    {"O2-customized", {"-O2", "--customization-budget", "256"}},
+};
+
+struct Measurement {
+  double medianMs{0.0};
+  int64_t maxRssKib{0};
+  int64_t allocations{0};
+  int64_t allocatedBytes{0};
+};
+
+struct Process {
+  int status{-1};
+  double wallMs{0.0};
+  int64_t maxRssKib{0};
+};
+
+// runs a command with the given files as stdin and stdout; rusage of the child gives its
+// peak resident memory
+Process runProcess(const std::vector<std::string>& args,
+                   const std::string& inputFile,
+                   const std::string& outputFile) {
+  std::vector<char*> argv{};
+  for (auto& arg : args) {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  Process process{};
+  auto start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid == 0) {
+    int input = open(inputFile.empty() ? "/dev/null" : inputFile.c_str(), O_RDONLY);
+    int output = open(outputFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if ((input < 0) || (output < 0)) {
+      _exit(127);
+    }
+    dup2(input, STDIN_FILENO);
+    dup2(output, STDOUT_FILENO);
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+  if (pid < 0) {
+    return process;
+  }
+
+  int status{0};
+  struct rusage usage {};
+  wait4(pid, &status, 0, &usage);
+  auto end = std::chrono::steady_clock::now();
+
+  process.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  process.wallMs = std::chrono::duration<double, std::milli>(end - start).count();
+  process.maxRssKib = usage.ru_maxrss;
+  return process;
+}
+
+std::vector<std::string> split(const std::string& command) {
+  std::istringstream stream(command);
+  std::vector<std::string> words{};
+  std::string word{};
+  while (stream >> word) {
+    words.push_back(word);
+  }
+  return words;
+}
+
+// io.cl reads a count followed by that many integers. std::minstd_rand is fully specified,
+// thus every platform generates the same numbers and the output stays comparable with io.out
+std::string generateIoInput() {
+  constexpr unsigned numValues{20000};
+  std::minstd_rand generator(53);
+  std::ostringstream stream;
+  stream << numValues << '\n';
+  for (unsigned i = 0; i < numValues; ++i) {
+    stream << generator() % 100000 << '\n';
+  }
+  return stream.str();
+}
+
+// inputs which are too large to be checked in are generated into the work directory
+const std::map<std::string, std::string (*)()> inputGenerators{
+    {"io", generateIoInput},
+};
+
+std::string readFile(const fs::path& path) {
+  std::ifstream stream(path);
+  std::stringstream content;
+  content << stream.rdbuf();
+  return content.str();
+}
+
+class Harness {
+  public:
+  explicit Harness(const Options& options) : options(options) {}
+
+  bool run();
+
+  private:
+  bool generateInputs(const std::vector<fs::path>& programs);
+  std::string getInputFile(const fs::path& program) const;
+  bool build(const fs::path& program,
+             const Configuration& configuration,
+             const std::vector<std::string>& extraFlags,
+             const fs::path& executable);
+  bool measure(const fs::path& program, const Configuration& configuration, Measurement& result);
+  bool countAllocations(const fs::path& program,
+                        const Configuration& configuration,
+                        Measurement& result);
+  void report(const std::string& program, const std::string& configuration);
+  void writeResults();
+
+  const Options& options;
+  llvm::json::Object results{};
+  llvm::json::Object baseline{};
+  unsigned numFailures{0};
+  unsigned numRegressions{0};
+};
+
+bool Harness::build(const fs::path& program,
+                    const Configuration& configuration,
+                    const std::vector<std::string>& extraFlags,
+                    const fs::path& executable) {
+  auto objectBase = executable.string();
+  std::vector<std::string> compile{
+      options.compiler, "-i", program.string(), "-o", objectBase};
+  compile.insert(compile.end(), configuration.flags.begin(), configuration.flags.end());
+  compile.insert(compile.end(), extraFlags.begin(), extraFlags.end());
+  auto log = objectBase + ".log";
+  if (runProcess(compile, "", log).status != 0) {
+    std::cerr << "cannot compile " << program << " (" << configuration.name << "), see " << log
+              << '\n';
+    return false;
+  }
+
+  auto link = split(options.linker);
+  link.insert(link.end(), {objectBase + ".o", "-o", objectBase});
+  if (runProcess(link, "", log).status != 0) {
+    std::cerr << "cannot link " << program << " (" << configuration.name << "), see " << log
+              << '\n';
+    return false;
+  }
+  return true;
+}
+
+bool Harness::generateInputs(const std::vector<fs::path>& programs) {
+  for (auto& program : programs) {
+    auto generator = inputGenerators.find(program.stem().string());
+    bool isCheckedIn = fs::exists(fs::path(program).replace_extension(".in"));
+    if ((generator == inputGenerators.end()) || isCheckedIn) {
+      continue;
+    }
+    auto inputFile = fs::path(options.workDir) / (program.stem().string() + ".in");
+    std::ofstream stream(inputFile);
+    stream << generator->second();
+    if (not stream) {
+      std::cerr << "cannot write input: " << inputFile << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+// a checked-in `<program>.in` takes precedence over a generated one
+std::string Harness::getInputFile(const fs::path& program) const {
+  auto inputFile = fs::path(program).replace_extension(".in");
+  if (fs::exists(inputFile)) {
+    return inputFile.string();
+  }
+  auto generatedFile = fs::path(options.workDir) / (program.stem().string() + ".in");
+  return fs::exists(generatedFile) ? generatedFile.string() : "";
+}
+
+// the output of every run is compared with `<program>.out`, if there is one
+bool Harness::measure(const fs::path& program,
+                      const Configuration& configuration,
+                      Measurement& result) {
+  auto name = program.stem().string();
+  auto executable = fs::path(options.workDir) / (name + "-" + configuration.name);
+  if (not build(program, configuration, {}, executable)) {
+    return false;
+  }
+
+  auto inputFile = getInputFile(program);
+  auto expectedFile = fs::path(program).replace_extension(".out");
+  auto outputFile = executable.string() + ".stdout";
+  std::vector<double> times{};
+  for (unsigned i = 0; i < options.numRuns; ++i) {
+    auto process = runProcess({executable.string()}, inputFile, outputFile);
+    if (process.status != 0) {
+      std::cerr << name << " (" << configuration.name << ") exited with " << process.status
+                << '\n';
+      return false;
+    }
+    if (fs::exists(expectedFile) && (readFile(outputFile) != readFile(expectedFile))) {
+      std::cerr << name << " (" << configuration.name << ") printed unexpected output, see "
+                << outputFile << '\n';
+      return false;
+    }
+    times.push_back(process.wallMs);
+    result.maxRssKib = std::max(result.maxRssKib, process.maxRssKib);
+  }
+
+  std::sort(times.begin(), times.end());
+  auto middle = times.size() / 2;
+  result.medianMs = (times.size() % 2 == 1) ? times[middle]
+                                            : (times[middle - 1] + times[middle]) / 2.0;
+  return true;
+}
+
+// allocations are counted by a separate build with `--heap-profile`, so that the counters
+// do not disturb the timed runs
+bool Harness::countAllocations(const fs::path& program,
+                               const Configuration& configuration,
+                               Measurement& result) {
+  auto name = program.stem().string();
+  auto executable = fs::path(options.workDir) / (name + "-" + configuration.name + "-heap");
+  auto heapProfile = executable.string() + ".heap";
+  if (not build(program, configuration, {"--heap-profile", heapProfile}, executable)) {
+    return false;
+  }
+
+  auto process =
+      runProcess({executable.string()}, getInputFile(program), executable.string() + ".stdout");
+  if (process.status != 0) {
+    return false;
+  }
+
+  // the table of classes comes first and ends with an empty line
+  std::ifstream stream(heapProfile);
+  std::string line{};
+  while (std::getline(stream, line) && (not line.empty())) {
+    if (line.front() == '#') {
+      continue;
+    }
+    std::istringstream lineStream(line);
+    int64_t objects{0};
+    int64_t bytes{0};
+    if (lineStream >> objects >> bytes) {
+      result.allocations += objects;
+      result.allocatedBytes += bytes;
+    }
+  }
+  return true;
+}
+
+bool Harness::run() {
+  std::error_code errorCode;
+  fs::create_directories(options.workDir, errorCode);
+  if (errorCode) {
+    std::cerr << "cannot create directory: " << options.workDir << '\n';
+    return false;
+  }
+
+  if (fs::exists(options.baselineFile)) {
+    auto buffer = llvm::MemoryBuffer::getFile(options.baselineFile);
+    auto parsed = buffer ? llvm::json::parse(buffer.get()->getBuffer())
+                         : llvm::Expected<llvm::json::Value>(llvm::json::Value(nullptr));
+    if ((not parsed) || (parsed->getAsObject() == nullptr)) {
+      llvm::consumeError(parsed.takeError());
+      std::cerr << "cannot read baseline: " << options.baselineFile << '\n';
+      return false;
+    }
+    baseline = std::move(*parsed->getAsObject());
+  }
+
+  std::vector<fs::path> programs{};
+  for (auto& entry : fs::directory_iterator(options.programsDir)) {
+    auto& path = entry.path();
+    bool isSelected = path.stem().string().find(options.filter) != std::string::npos;
+    if ((path.extension() == ".cl") && isSelected) {
+      programs.push_back(path);
+    }
+  }
+  std::sort(programs.begin(), programs.end());
+  if (not generateInputs(programs)) {
+    return false;
+  }
+
+  std::cout << std::left << std::setw(14) << "program" << std::setw(16) << "configuration"
+            << std::right << std::setw(12) << "median ms" << std::setw(14) << "max rss KiB"
+            << std::setw(14) << "allocations" << "  vs baseline\n";
+  for (auto& program : programs) {
+    auto name = program.stem().string();
+    llvm::json::Object programResults{};
+    for (auto& configuration : configurations) {
+      Measurement measurement{};
+      if (not(measure(program, configuration, measurement) &&
+              countAllocations(program, configuration, measurement))) {
+        ++numFailures;
+        continue;
+      }
+      programResults[configuration.name] = llvm::json::Object{
+          {"median_us", static_cast<int64_t>(measurement.medianMs * 1000.0)},
+          {"max_rss_kib", measurement.maxRssKib},
+          {"allocations", measurement.allocations},
+          {"allocated_bytes", measurement.allocatedBytes},
+      };
+    }
+    results[name] = std::move(programResults);
+    for (auto& configuration : configurations) {
+      report(name, configuration.name);
+    }
+  }
+
+  writeResults();
+  std::cout << numRegressions << " regression(s), " << numFailures << " failure(s)\n";
+  return (numFailures == 0) && (numRegressions == 0);
+}
+
+// time and memory regress beyond the threshold, any new allocation is a regression
+void Harness::report(const std::string& program, const std::string& configuration) {
+  auto* programResults = results.getObject(program);
+  auto* measurement = programResults ? programResults->getObject(configuration) : nullptr;
+  if (measurement == nullptr) {
+    return;
+  }
+  auto medianMs = measurement->getInteger("median_us").getValueOr(0) / 1000.0;
+  auto maxRss = measurement->getInteger("max_rss_kib").getValueOr(0);
+  auto allocations = measurement->getInteger("allocations").getValueOr(0);
+
+  std::cout << std::left << std::setw(14) << program << std::setw(16) << configuration
+            << std::right << std::fixed << std::setprecision(2) << std::setw(12) << medianMs
+            << std::setw(14) << maxRss << std::setw(14) << allocations;
+
+  auto* baselineProgram = baseline.getObject(program);
+  auto* baselineMeasurement =
+      baselineProgram ? baselineProgram->getObject(configuration) : nullptr;
+  if (baselineMeasurement == nullptr) {
+    std::cout << "  (new)\n";
+    return;
+  }
+
+  auto baselineMs = baselineMeasurement->getInteger("median_us").getValueOr(0) / 1000.0;
+  auto baselineRss = baselineMeasurement->getInteger("max_rss_kib").getValueOr(0);
+  auto baselineAllocations = baselineMeasurement->getInteger("allocations").getValueOr(0);
+
+  auto timeDelta = (baselineMs > 0.0) ? (medianMs / baselineMs - 1.0) : 0.0;
+  std::cout << "  " << std::showpos << std::setprecision(1) << timeDelta * 100.0 << "%"
+            << std::noshowpos;
+
+  std::vector<std::string> regressions{};
+  if (timeDelta > options.threshold) {
+    regressions.push_back("time");
+  }
+  if (static_cast<double>(maxRss) > static_cast<double>(baselineRss) * (1.0 + options.threshold)) {
+    regressions.push_back("rss");
+  }
+  if (allocations > baselineAllocations) {
+    regressions.push_back("allocations");
+  }
+  for (auto& regression : regressions) {
+    std::cout << " REGRESSION(" << regression << ")";
+  }
+  numRegressions += regressions.size();
+  std::cout << '\n';
+}
+
+void Harness::writeResults() {
+  if (options.outputFile.empty()) {
+    return;
+  }
+  std::error_code errorCode;
+  llvm::raw_fd_ostream stream(options.outputFile, errorCode);
+  if (errorCode) {
+    std::cerr << "cannot write results: " << options.outputFile << '\n';
+    ++numFailures;
+    return;
+  }
+  stream << llvm::formatv("{0:2}", llvm::json::Value(std::move(results))) << '\n';
+}
+} // namespace
+} // namespace mcool::benchmarks
+
+// compiles every program of the corpus in every configuration, runs it several times and
+// compares median time, peak memory and allocations with a baseline
+int main(int argc, char* argv[]) {
+  mcool::benchmarks::Options options{};
+
+  CLI::App cmd{"runtime benchmarks of generated code"};
+  cmd.add_option("--compiler", options.compiler, "mcool executable");
+  cmd.add_option("--programs", options.programsDir, "directory of .cl programs");
+  cmd.add_option("--baseline", options.baselineFile, "json results to compare with");
+  cmd.add_option("-o,--output", options.outputFile, "write results as json to the file");
+  cmd.add_option("--work-dir", options.workDir, "directory of executables and outputs");
+  cmd.add_option("--linker", options.linker, "command which links an object file");
+  cmd.add_option("--filter", options.filter, "run programs whose names contain the string");
+  cmd.add_option("--runs", options.numRuns, "runs per program and configuration")
+      ->check(CLI::Range(1, 1000));
+  cmd.add_option("--threshold", options.threshold, "relative slowdown reported as regression");
+  try {
+    cmd.parse(argc, argv);
+  } catch (const CLI::ParseError& err) {
+    return cmd.exit(err);
+  }
+
+  mcool::benchmarks::Harness harness(options);
+  return harness.run() ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+(* nested loops of integer arithmetic *)
+class Main inherits IO {
+  mod(a: Int, b: Int): Int { a - (a / b) * b };
+
+  main(): Object {
+    let i: Int <- 0, sum: Int <- 0 in {
+      while i < 1500 loop {
+        let j: Int <- 0 in
+          while j < 1500 loop {
+            sum <- mod(sum + i * j + 7, 1000003);
+            j <- j + 1;
+          } pool;
+        i <- i + 1;
+      } pool;
+      out_int(sum);
+      out_string("\n");
+    }
+  };
+};
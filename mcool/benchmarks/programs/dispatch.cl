@@ -0,0 +1,54 @@
+(* virtual calls on receivers of several classes *)
+class Shape {
+  scale: Int <- 1;
+  init(s: Int): Shape {{ scale <- s; self; }};
+  area(): Int { 0 };
+  perimeter(): Int { 0 };
+};
+
+class Square inherits Shape {
+  area(): Int { scale * scale };
+  perimeter(): Int { 4 * scale };
+};
+
+class Rectangle inherits Shape {
+  area(): Int { scale * (scale + 1) };
+  perimeter(): Int { 4 * scale + 2 };
+};
+
+class Triangle inherits Shape {
+  area(): Int { (scale * scale) / 2 };
+  perimeter(): Int { 3 * scale };
+};
+
+class Circle inherits Shape {
+  area(): Int { (314 * scale * scale) / 100 };
+  perimeter(): Int { (628 * scale) / 100 };
+};
+
+class Main inherits IO {
+  shapes: Shape;
+
+  make(i: Int): Shape {
+    let k: Int <- i - (i / 4) * 4, shape: Shape in {
+      if k = 0 then shape <- new Square else
+      if k = 1 then shape <- new Rectangle else
+      if k = 2 then shape <- new Triangle else shape <- new Circle fi fi fi;
+      shape.init(i);
+    }
+  };
+
+  main(): Object {
+    let round: Int <- 0, sum: Int <- 0, a: Shape <- make(1), b: Shape <- make(2),
+        c: Shape <- make(3), d: Shape <- make(4) in {
+      while round < 300000 loop {
+        sum <- sum + a.area() + b.perimeter() + c.area() + d.perimeter();
+        sum <- sum - (sum / 1000003) * 1000003;
+        let t: Shape <- a in { a <- b; b <- c; c <- d; d <- t; };
+        round <- round + 1;
+      } pool;
+      out_int(sum);
+      out_string("\n");
+    }
+  };
+};
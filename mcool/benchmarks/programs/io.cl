@@ -0,0 +1,25 @@
+(* reading integers and writing lines *)
+class Main inherits IO {
+  main(): Object {
+    let count: Int <- in_int(), i: Int <- 0, sum: Int <- 0, max: Int <- 0 in {
+      while i < count loop {
+        let value: Int <- in_int() in {
+          sum <- sum + value;
+          sum <- sum - (sum / 1000003) * 1000003;
+          if max < value then max <- value else max fi;
+          if value - (value / 1000) * 1000 = 0 then {
+            out_int(i);
+            out_string(": ");
+            out_int(value);
+            out_string("\n");
+          } else 0 fi;
+        };
+        i <- i + 1;
+      } pool;
+      out_int(sum);
+      out_string(" ");
+      out_int(max);
+      out_string("\n");
+    }
+  };
+};
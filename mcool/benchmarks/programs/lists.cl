@@ -0,0 +1,67 @@
+(* building, reversing, summing and sorting linked lists *)
+class List {
+  isNil(): Bool { true };
+  head(): Int { { abort(); 0; } };
+  tail(): List { { abort(); self; } };
+  cons(i: Int): List { let cell: Cons <- new Cons in cell.init(i, self) };
+};
+
+class Cons inherits List {
+  car: Int;
+  cdr: List;
+  isNil(): Bool { false };
+  head(): Int { car };
+  tail(): List { cdr };
+  init(i: Int, rest: List): List {{ car <- i; cdr <- rest; self; }};
+};
+
+class Main inherits IO {
+  nil: List <- new List;
+
+  range(n: Int): List {
+    let list: List <- nil, i: Int <- 0 in {
+      while i < n loop { list <- list.cons(i * 7919 - ((i * 7919) / 10007) * 10007); i <- i + 1; } pool;
+      list;
+    }
+  };
+
+  reverse(list: List): List {
+    let result: List <- nil in {
+      while not list.isNil() loop { result <- result.cons(list.head()); list <- list.tail(); } pool;
+      result;
+    }
+  };
+
+  sum(list: List): Int {
+    let result: Int <- 0 in {
+      while not list.isNil() loop { result <- result + list.head(); list <- list.tail(); } pool;
+      result;
+    }
+  };
+
+  insert(i: Int, list: List): List {
+    if list.isNil() then nil.cons(i) else
+      if i <= list.head() then list.cons(i) else insert(i, list.tail()).cons(list.head()) fi
+    fi
+  };
+
+  sort(list: List): List {
+    let result: List <- nil in {
+      while not list.isNil() loop { result <- insert(list.head(), result); list <- list.tail(); } pool;
+      result;
+    }
+  };
+
+  main(): Object {
+    let long: List <- range(200000), short: List <- sort(range(1500)) in {
+      out_int(sum(reverse(long)) - sum(long));
+      out_string(" ");
+      out_int(short.head());
+      out_string(" ");
+      out_int(reverse(short).head());
+      out_string(" ");
+      out_int(sum(short));
+      out_string("\n");
+    }
+  };
+};
@@ -0,0 +1,25 @@
+(* deep and wide recursion *)
+class Main inherits IO {
+  fibonacci(n: Int): Int {
+    if n < 2 then n else fibonacci(n - 1) + fibonacci(n - 2) fi
+  };
+
+  depth(n: Int): Int {
+    if n = 0 then 0 else 1 + depth(n - 1) fi
+  };
+
+  ackermann(m: Int, n: Int): Int {
+    if m = 0 then n + 1 else
+      if n = 0 then ackermann(m - 1, 1) else ackermann(m - 1, ackermann(m, n - 1)) fi
+    fi
+  };
+
+  main(): Object {{
+    out_int(fibonacci(25));
+    out_string(" ");
+    out_int(depth(20000));
+    out_string(" ");
+    out_int(ackermann(2, 500));
+    out_string("\n");
+  }};
+};
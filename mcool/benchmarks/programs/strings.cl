@@ -0,0 +1,39 @@
+(* building, slicing and comparing strings *)
+class Main inherits IO {
+  digits: String <- "0123456789";
+
+  toString(i: Int): String {
+    if i < 10 then digits.substr(i, 1) else
+      toString(i / 10).concat(digits.substr(i - (i / 10) * 10, 1))
+    fi
+  };
+
+  reverse(s: String): String {
+    let result: String <- "", i: Int <- s.length() in {
+      while 0 < i loop { i <- i - 1; result <- result.concat(s.substr(i, 1)); } pool;
+      result;
+    }
+  };
+
+  main(): Object {
+    let i: Int <- 0, line: String <- "", total: Int <- 0, palindromes: Int <- 0 in {
+      while i < 3000 loop {
+        line <- line.concat(toString(i)).concat(",");
+        i <- i + 1;
+      } pool;
+      i <- 0;
+      while i < 20000 loop {
+        let s: String <- toString(i) in
+          if s = reverse(s) then palindromes <- palindromes + 1 else palindromes fi;
+        total <- total + toString(i * 31).length();
+        i <- i + 1;
+      } pool;
+      out_int(line.length());
+      out_string(" ");
+      out_int(palindromes);
+      out_string(" ");
+      out_int(total);
+      out_string("\n");
+    }
+  };
+};
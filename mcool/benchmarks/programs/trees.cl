@@ -0,0 +1,72 @@
+(* binary search trees of pseudo-random keys *)
+class Tree {
+  isEmpty(): Bool { true };
+  insert(key: Int): Tree { let node: Node <- new Node in node.init(key, self, self) };
+  size(): Int { 0 };
+  height(): Int { 0 };
+  sum(): Int { 0 };
+  contains(key: Int): Bool { false };
+};
+
+class Node inherits Tree {
+  key: Int;
+  left: Tree;
+  right: Tree;
+
+  init(k: Int, l: Tree, r: Tree): Tree {{ key <- k; left <- l; right <- r; self; }};
+  isEmpty(): Bool { false };
+
+  insert(k: Int): Tree {{
+    if k < key then left <- left.insert(k) else
+      if key < k then right <- right.insert(k) else self fi
+    fi;
+    self;
+  }};
+
+  size(): Int { 1 + left.size() + right.size() };
+
+  height(): Int {
+    let l: Int <- left.height(), r: Int <- right.height() in
+      if l < r then r + 1 else l + 1 fi
+  };
+
+  sum(): Int {
+    let s: Int <- key + left.sum() + right.sum() in s - (s / 1000003) * 1000003
+  };
+
+  contains(k: Int): Bool {
+    if k < key then left.contains(k) else
+      if key < k then right.contains(k) else true fi
+    fi
+  };
+};
+
+class Main inherits IO {
+  seed: Int <- 12345;
+
+  next(): Int {{
+    seed <- seed * 1103 + 12345;
+    seed <- seed - (seed / 1000003) * 1000003;
+    if seed < 0 then seed <- 0 - seed else seed fi;
+  }};
+
+  main(): Object {
+    let tree: Tree <- new Tree, i: Int <- 0, found: Int <- 0 in {
+      while i < 50000 loop { tree <- tree.insert(next()); i <- i + 1; } pool;
+      seed <- 12345;
+      i <- 0;
+      while i < 100000 loop {
+        if tree.contains(next()) then found <- found + 1 else found fi;
+        i <- i + 1;
+      } pool;
+      out_int(tree.size());
+      out_string(" ");
+      out_int(tree.height());
+      out_string(" ");
+      out_int(tree.sum());
+      out_string(" ");
+      out_int(found);
+      out_string("\n");
+    }
+  };
+};
@@ -0,0 +1,35 @@
+#include "Arena.h"
+
+namespace mcool {
+Arena::Arena(Arena&& other) noexcept
+    : slabSize(other.slabSize), slabs(std::move(other.slabs)), current(other.current),
+      end(other.end), finalizers(other.finalizers), allocatedBytes(other.allocatedBytes) {
+  other.slabs.clear();
+  other.current = nullptr;
+  other.end = nullptr;
+  other.finalizers = nullptr;
+  other.allocatedBytes = 0;
+}
+
+Arena::~Arena() {
+  for (auto* finalizer = finalizers; finalizer != nullptr; finalizer = finalizer->next) {
+    finalizer->destroy(finalizer->object);
+  }
+}
+
+// objects larger than a slab get a slab of their own; the current slab stays in use then
+void* Arena::allocateSlab(size_t size, size_t alignment) {
+  // `new[]` aligns slabs at least as `std::max_align_t`
+  assert(alignment <= alignof(std::max_align_t));
+  if (size > slabSize / 2) {
+    slabs.emplace_back(new std::byte[size]);
+    allocatedBytes += size;
+    return slabs.back().get();
+  }
+
+  slabs.emplace_back(new std::byte[slabSize]);
+  current = slabs.back().get();
+  end = current + slabSize;
+  return allocate(size, alignment);
+}
+} // namespace mcool
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mcool {
+// Bump-pointer allocator which owns every object created in it. Memory is taken from slabs
+// and released all at once together with the arena. Destructors of objects which need them
+// run in the reverse order of creation.
+class Arena {
+  public:
+  static constexpr size_t defaultSlabSize{64 * 1024};
+
+  explicit Arena(size_t slabSize = defaultSlabSize) : slabSize(slabSize) {}
+  Arena(Arena&& other) noexcept;
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  Arena& operator=(Arena&&) = delete;
+  ~Arena();
+
+  template <typename Type, typename... Args>
+  Type* create(Args&&... args);
+
+  void* allocate(size_t size, size_t alignment);
+
+  size_t getNumSlabs() const { return slabs.size(); }
+  size_t getAllocatedBytes() const { return allocatedBytes; }
+
+  private:
+  struct Finalizer {
+    void (*destroy)(void*);
+    void* object;
+    Finalizer* next;
+  };
+
+  template <typename Type>
+  static void destroy(void* object) {
+    static_cast<Type*>(object)->~Type();
+  }
+
+  void* allocateSlab(size_t size, size_t alignment);
+
+  size_t slabSize;
+  std::vector<std::unique_ptr<std::byte[]>> slabs{};
+  std::byte* current{nullptr};
+  std::byte* end{nullptr};
+  Finalizer* finalizers{nullptr};
+  size_t allocatedBytes{0};
+};
+
+template <typename Type, typename... Args>
+Type* Arena::create(Args&&... args) {
+  static_assert(alignof(Type) <= alignof(std::max_align_t), "over-aligned types are not supported");
+  auto* object = new (allocate(sizeof(Type), alignof(Type))) Type(std::forward<Args>(args)...);
+  if constexpr (not std::is_trivially_destructible_v<Type>) {
+    auto* memory = allocate(sizeof(Finalizer), alignof(Finalizer));
+    finalizers = new (memory) Finalizer{&Arena::destroy<Type>, object, finalizers};
+  }
+  return object;
+}
+
+inline void* Arena::allocate(size_t size, size_t alignment) {
+  assert((alignment != 0) && ((alignment & (alignment - 1)) == 0));
+  auto address = reinterpret_cast<uintptr_t>(current);
+  auto padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+  if ((current == nullptr) || (static_cast<size_t>(end - current) < padding + size)) {
+    return allocateSlab(size, alignment);
+  }
+  auto* ptr = current + padding;
+  current = ptr + size;
+  allocatedBytes += size;
+  return ptr;
+}
+} // namespace mcool
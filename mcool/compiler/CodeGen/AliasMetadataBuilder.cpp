@@ -0,0 +1,136 @@
+#include "CodeGen/AliasMetadataBuilder.h"
+#include "CodeGen/Misc.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/IR/Operator.h"
+#include <array>
+
+namespace mcool::codegen {
+namespace {
+const std::array<std::string, 4> headerFieldNames{"gc_tag", "class_tag", "size", "disp_table"};
+} // namespace
+
+void AliasMetadataBuilder::build() {
+  initStructTables();
+
+  llvm::MDBuilder mdBuilder(*context);
+  root = mdBuilder.createTBAARoot("mcool TBAA");
+
+  for (auto& function : *module) {
+    for (auto& block : function) {
+      for (auto& instruction : block) {
+        if (auto* load = llvm::dyn_cast<llvm::LoadInst>(&instruction)) {
+          decorate(load, load->getPointerOperand());
+        } else if (auto* store = llvm::dyn_cast<llvm::StoreInst>(&instruction)) {
+          decorate(store, store->getPointerOperand());
+        }
+      }
+    }
+  }
+}
+
+void AliasMetadataBuilder::initStructTables() {
+  for (auto* coolClass : classes.get()->getData()) {
+    auto& className = coolClass->getCoolType()->getNameAsStr();
+
+    auto* classType = llvm::StructType::getTypeByName(*context, className);
+    assert(classType != nullptr);
+    classTypes.insert({classType, className});
+
+    auto dispatchTableTypeName = getDispatchTableTypeName(className);
+    auto* dispatchTableType = llvm::StructType::getTypeByName(*context, dispatchTableTypeName);
+    assert(dispatchTableType != nullptr);
+    dispatchTableTypes.insert({dispatchTableType, className});
+
+    for (auto* attr : coolClass->getAttributes()->getData()) {
+      if (auto* member = llvm::dyn_cast<ast::SingleMember>(attr)) {
+        memberOwners.insert({member, className});
+      }
+    }
+  }
+}
+
+void AliasMetadataBuilder::decorate(llvm::Instruction* access, llvm::Value* address) {
+  auto* gep = llvm::dyn_cast<llvm::GEPOperator>(address);
+  if (gep == nullptr) {
+    return;
+  }
+
+  bool isLoad = llvm::isa<llvm::LoadInst>(access);
+  auto* invariantNode = llvm::MDNode::get(*context, {});
+
+  auto* global = llvm::dyn_cast<llvm::GlobalVariable>(gep->getPointerOperand());
+  if (isLoad && (global != nullptr) && global->isConstant()) {
+    access->setMetadata(llvm::LLVMContext::MD_invariant_load, invariantNode);
+  }
+
+  auto* structType = llvm::dyn_cast<llvm::StructType>(gep->getSourceElementType());
+  if (structType == nullptr) {
+    return;
+  }
+
+  if (dispatchTableTypes.find(structType) != dispatchTableTypes.end()) {
+    access->setMetadata(llvm::LLVMContext::MD_tbaa, getTag("DispTable.slot"));
+    if (isLoad) {
+      access->setMetadata(llvm::LLVMContext::MD_invariant_load, invariantNode);
+    }
+    return;
+  }
+
+  bool isObjectField = (gep->getNumIndices() == 2) && gep->hasAllConstantIndices();
+  if ((not isObjectField) || (classTypes.find(structType) == classTypes.end())) {
+    return;
+  }
+
+  auto* fieldIndexValue = llvm::cast<llvm::ConstantInt>(gep->getOperand(2));
+  auto fieldIndex = static_cast<unsigned>(fieldIndexValue->getZExtValue());
+  if (auto* tag = getFieldTag(structType, fieldIndex)) {
+    access->setMetadata(llvm::LLVMContext::MD_tbaa, tag);
+  }
+}
+
+llvm::MDNode* AliasMetadataBuilder::getFieldTag(llvm::StructType* structType,
+                                                unsigned fieldIndex) {
+  auto key = std::make_pair(structType, fieldIndex);
+  auto it = fieldTags.find(key);
+  if (it != fieldTags.end()) {
+    return it->second;
+  }
+
+  auto& className = classTypes[structType];
+  std::string fieldName{};
+  if (fieldIndex < headerFieldNames.size()) {
+    fieldName = "Object." + headerFieldNames[fieldIndex];
+  } else if ((className == "Int") || (className == "Bool")) {
+    fieldName = className + ".value";
+  } else if (className == "String") {
+    fieldName = (fieldIndex == 4) ? "String.length" : "String.str";
+  } else {
+    for (auto scope : env.globalMembersTable[className].getScopes()) {
+      for (auto& item : scope) {
+        if (static_cast<unsigned>(item.value.offset) == fieldIndex) {
+          auto& ownerName = memberOwners[item.value.member];
+          fieldName = ownerName + "." + item.value.member->getId()->getNameAsStr();
+        }
+      }
+    }
+  }
+
+  auto* tag = fieldName.empty() ? nullptr : getTag(fieldName);
+  fieldTags.insert({key, tag});
+  return tag;
+}
+
+llvm::MDNode* AliasMetadataBuilder::getTag(const std::string& name) {
+  auto it = tags.find(name);
+  if (it != tags.end()) {
+    return it->second;
+  }
+
+  llvm::MDBuilder mdBuilder(*context);
+  auto* scalarType = mdBuilder.createTBAAScalarTypeNode(name, root);
+  auto* tag = mdBuilder.createTBAAStructTagNode(scalarType, scalarType, 0);
+  tags.insert({name, tag});
+  return tag;
+}
+} // namespace mcool::codegen
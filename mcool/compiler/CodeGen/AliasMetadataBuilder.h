@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CodeGen/BaseBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Metadata.h"
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace mcool::codegen {
+// Attaches `!tbaa` metadata to object field accesses and `!invariant.load` to loads from
+// dispatch tables and other constant globals. Every field gets its own scalar type, named
+// after the class which declares it, so that accesses to different fields never alias.
+// Header fields belong to `Object`. Object headers are filled by a memcpy after allocation,
+// hence loads of class tags and dispatch table pointers cannot be marked invariant.
+class AliasMetadataBuilder : public BaseBuilder {
+  public:
+  explicit AliasMetadataBuilder(Environment& env, mcool::AstTree& classes)
+      : BaseBuilder(env), classes(classes) {}
+  void build();
+
+  private:
+  void initStructTables();
+  void decorate(llvm::Instruction* access, llvm::Value* address);
+  llvm::MDNode* getFieldTag(llvm::StructType* structType, unsigned fieldIndex);
+  llvm::MDNode* getTag(const std::string& name);
+
+  mcool::AstTree& classes;
+  llvm::MDNode* root{};
+
+  std::unordered_map<llvm::StructType*, std::string> classTypes{};
+  std::unordered_map<llvm::StructType*, std::string> dispatchTableTypes{};
+  std::unordered_map<ast::SingleMember*, std::string> memberOwners{};
+  std::map<std::pair<llvm::StructType*, unsigned>, llvm::MDNode*> fieldTags{};
+  std::unordered_map<std::string, llvm::MDNode*> tags{};
+};
+} // namespace mcool::codegen
@@ -6,6 +6,9 @@
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Support/Casting.h"
 
 namespace mcool::codegen {
 class BaseBuilder {
@@ -44,6 +47,7 @@ class BaseBuilder {
 
     auto copyObjectMethodName = getMethodName("Object", "copy");
     auto* copyObjectMethod = module->getFunction(copyObjectMethodName);
+    setAllocationSite();
     auto* newObject = builder->CreateCall(copyObjectMethod, objPtr);
 
     return builder->CreateBitCast(newObject, getPtrType(className));
@@ -70,6 +74,7 @@ class BaseBuilder {
     auto* copyObjectMethod = module->getFunction(copyObjectMethodName);
 
     auto* castedObjPtr = builder->CreateBitCast(objPtr, getPtrType("Object"));
+    setAllocationSite();
     auto* newObject = builder->CreateCall(copyObjectMethod, castedObjPtr);
     return builder->CreateBitCast(newObject, objPtr->getType());
   }
@@ -115,12 +120,123 @@ class BaseBuilder {
   }
 
   void assertNotNullptr(llvm::Value* coolObjPtr) {
-    auto* objPtrType = getPtrType("Object");
-    auto* objPtr = builder->CreateBitCast(coolObjPtr, objPtrType);
+    auto* objPtrType = llvm::cast<llvm::PointerType>(coolObjPtr->getType());
+    auto* nullPtr = llvm::ConstantPointerNull::get(objPtrType);
+    auto* isNull = builder->CreateICmpEQ(coolObjPtr, nullPtr);
+
+    auto* parentFunction = builder->GetInsertBlock()->getParent();
+    auto* abortBB = llvm::BasicBlock::Create(*context, "", parentFunction);
+    auto* continueBB = llvm::BasicBlock::Create(*context);
+
+    llvm::MDBuilder mdBuilder(*context);
+    builder->CreateCondBr(isNull, abortBB, continueBB, mdBuilder.createBranchWeights(1, 1 << 20));
+
+    builder->SetInsertPoint(abortBB);
+    auto* abortOnNullptrFunc = module->getFunction("_abort_on_nullptr");
+    assert(abortOnNullptrFunc != nullptr);
+    builder->CreateCall(abortOnNullptrFunc);
+    builder->CreateUnreachable();
+
+    parentFunction->getBasicBlockList().push_back(continueBB);
+    builder->SetInsertPoint(continueBB);
+  }
+
+  SymbolId getSymbolId(const std::string& name) {
+    return env.coolContext.getMemoryManager().getSymbolId(name);
+  }
+
+  // a slot of a customized method refers to the clone made for the class itself
+  std::string getImplementationName(const std::string& className, const MethodsTableData& data) {
+    auto& ownerName = data.owner->getCoolType()->getNameAsStr();
+    auto& methodName = data.method->getId()->getNameAsStr();
+    return getMethodName(data.isCustomized ? className : ownerName, methodName);
+  }
+
+  static bool isSelfReference(ast::Node* node) {
+    while (auto* primary = llvm::dyn_cast<ast::PrimaryExpr>(node)) {
+      node = primary->getTerm();
+    }
+    auto* id = llvm::dyn_cast<ast::ObjectId>(node);
+    return (id != nullptr) && (id->getNameAsStr() == "self");
+  }
+
+  // works for both `llvm::Function` and `llvm::CallBase`
+  template <typename T>
+  void addEffectAttributes(T* target, const MethodEffects& effects) {
+    target->addFnAttr(llvm::Attribute::NoUnwind);
+    if (not effects.mayNotReturn) {
+      target->addFnAttr(llvm::Attribute::WillReturn);
+    }
+
+    if (effects.returnsNewObject) {
+      target->addAttribute(llvm::AttributeList::ReturnIndex, llvm::Attribute::NonNull);
+      target->addAttribute(llvm::AttributeList::ReturnIndex, llvm::Attribute::NoAlias);
+    }
 
-    auto* assertNotNullptrFunc = module->getFunction("_assert_not_nullptr");
-    assert(assertNotNullptrFunc != nullptr);
-    builder->CreateCall(assertNotNullptrFunc, objPtr);
+    if (effects.hasImmutableResult && (not effects.writesMemory)) {
+      target->addFnAttr(effects.readsMemory ? llvm::Attribute::ReadOnly
+                                            : llvm::Attribute::ReadNone);
+    }
+  }
+
+  // a site is named after the current source location or, without one, after the function
+  llvm::GlobalVariable* getAllocationSite() {
+    std::string siteName = builder->GetInsertBlock()->getParent()->getName().str();
+    if (auto* location = builder->getCurrentDebugLocation().get()) {
+      siteName = location->getFilename().str() + ":" + std::to_string(location->getLine()) +
+                 ":" + std::to_string(location->getColumn()) + " " + siteName;
+    }
+
+    return getHeapSite(siteName);
+  }
+
+  llvm::GlobalVariable* getHeapSite(const std::string& siteName) {
+    auto it = env.heapSites.find(siteName);
+    if (it == env.heapSites.end()) {
+      auto* siteType = llvm::StructType::getTypeByName(*context, getHeapSiteTypeName());
+      assert(siteType != nullptr);
+      auto* name = builder->CreateGlobalStringPtr(siteName, "", 0, module.get());
+      auto* initializer = llvm::ConstantStruct::get(
+          siteType, {name, builder->getInt64(0), builder->getInt64(0)});
+      auto* site = new llvm::GlobalVariable(*module,
+                                            siteType,
+                                            false,
+                                            llvm::GlobalValue::PrivateLinkage,
+                                            initializer,
+                                            getHeapSiteName());
+      it = env.heapSites.insert({siteName, site}).first;
+    }
+    return it->second;
+  }
+
+  // attributes the next call of `Object_copy` to the current allocation site, see `--heap-profile`
+  void setAllocationSite() {
+    auto* currentSite = module->getGlobalVariable(getHeapCurrentSiteName(), true);
+    if (currentSite != nullptr) {
+      builder->CreateStore(getAllocationSite(), currentSite);
+    }
+  }
+
+  // records memory which belongs to an object but is allocated apart from it
+  void recordHeapBytes(const std::string& className, llvm::Value* numBytes) {
+    auto* recordFunc = module->getFunction(getHeapRecorderName());
+    if (recordFunc != nullptr) {
+      auto* classTag = builder->getInt32(env.classTagTable.at(className));
+      builder->CreateCall(recordFunc,
+                          {getAllocationSite(), classTag, numBytes, builder->getInt64(0)});
+    }
+  }
+
+  // reports a decision of the compiler at the current debug location, see `--opt-remarks`
+  template <typename RemarkType, typename... Args>
+  void emitRemark(const char* passName, const char* remarkName, Args&&... args) {
+    if (context->getLLVMRemarkStreamer() == nullptr) {
+      return;
+    }
+    RemarkType remark(
+        passName, remarkName, builder->getCurrentDebugLocation(), builder->GetInsertBlock());
+    (remark << ... << std::forward<Args>(args));
+    context->diagnose(remark);
   }
 
   protected:
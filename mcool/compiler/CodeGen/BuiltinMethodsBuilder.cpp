@@ -16,7 +16,7 @@ void BuiltinMethodsBuilder::build() {
   genStringLength();
   genStringConcat();
   genStringSubstr();
-  genNullPtrCheck();
+  genNullPtrAbort();
 }
 
 void BuiltinMethodsBuilder::genCStdFunctions() {
@@ -47,6 +47,7 @@ void BuiltinMethodsBuilder::genCStdFunctions() {
     auto* funcType = llvm::FunctionType::get(voidType, intType, false);
     auto* func = llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, "exit", *module);
     func->setCallingConv(llvm::CallingConv::C);
+    func->setDoesNotReturn();
   }
   {
     auto* funcType = llvm::FunctionType::get(intType, {charPtrType}, true);
@@ -78,6 +79,48 @@ void BuiltinMethodsBuilder::genCStdFunctions() {
         llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, "strcmp", *module);
     func->setCallingConv(llvm::CallingConv::C);
   }
+  // used by profile writers
+  {
+    auto* funcType = llvm::FunctionType::get(bytePtrType, {charPtrType, charPtrType}, false);
+    auto* func =
+        llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, "fopen", *module);
+    func->setCallingConv(llvm::CallingConv::C);
+  }
+  {
+    auto* funcType = llvm::FunctionType::get(intType, {bytePtrType, charPtrType}, true);
+    auto* func =
+        llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, "fprintf", *module);
+    func->setCallingConv(llvm::CallingConv::C);
+  }
+  {
+    auto* funcType = llvm::FunctionType::get(intType, {bytePtrType}, false);
+    auto* func =
+        llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, "fclose", *module);
+    func->setCallingConv(llvm::CallingConv::C);
+  }
+  {
+    auto* handlerType = llvm::FunctionType::get(voidType, {}, false);
+    auto* funcType = llvm::FunctionType::get(intType, {handlerType->getPointerTo()}, false);
+    auto* func =
+        llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, "atexit", *module);
+    func->setCallingConv(llvm::CallingConv::C);
+  }
+  {
+    auto* handlerType = llvm::FunctionType::get(voidType, {intType}, false);
+    auto* funcType = llvm::FunctionType::get(
+        handlerType->getPointerTo(), {intType, handlerType->getPointerTo()}, false);
+    auto* func =
+        llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, "signal", *module);
+    func->setCallingConv(llvm::CallingConv::C);
+  }
+  {
+    auto* compareType = llvm::FunctionType::get(intType, {bytePtrType, bytePtrType}, false);
+    auto* funcType = llvm::FunctionType::get(
+        voidType, {bytePtrType, sizeType, sizeType, compareType->getPointerTo()}, false);
+    auto* func =
+        llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, "qsort", *module);
+    func->setCallingConv(llvm::CallingConv::C);
+  }
 }
 
 void BuiltinMethodsBuilder::genClearStdinBuffer() {
@@ -136,6 +179,18 @@ void BuiltinMethodsBuilder::genObjectCopy() {
   assert(mallocType != nullptr);
   auto* memory = builder->CreateCall(mallocType, objSize);
 
+  // the caller has set the allocation site; later calls are unattributed unless set again
+  auto* currentSite = module->getGlobalVariable(getHeapCurrentSiteName(), true);
+  if (currentSite != nullptr) {
+    auto* recordFunc = module->getFunction(getHeapRecorderName());
+    assert(recordFunc != nullptr);
+    auto* classTagAddress = builder->CreateGEP(coolObjectType, objPtr, getGepIndices({0, 1}));
+    auto* classTag = builder->CreateLoad(builder->getInt32Ty(), classTagAddress);
+    builder->CreateCall(
+        recordFunc, {builder->CreateLoad(currentSite), classTag, objSize, builder->getInt64(1)});
+    builder->CreateStore(currentSite->getInitializer(), currentSite);
+  }
+
   builder->CreateMemCpy(memory, memory->getParamAlign(0), objPtr, objPtr->getParamAlign(), objSize);
 
   auto* returnObj = builder->CreateBitCast(memory, coolObjectPtrType);
@@ -146,6 +201,9 @@ void BuiltinMethodsBuilder::genObjectCopy() {
 
 void BuiltinMethodsBuilder::genObjectAbort() {
   auto methodName = getMethodName("Object", "abort");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -169,6 +227,9 @@ void BuiltinMethodsBuilder::genObjectAbort() {
 
 void BuiltinMethodsBuilder::genObjectTypeName() {
   auto methodName = getMethodName("Object", "type_name");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -183,6 +244,7 @@ void BuiltinMethodsBuilder::genObjectTypeName() {
   auto* mallocFunc = module->getFunction("malloc");
   assert(mallocFunc != nullptr);
   auto* newStrMemory = builder->CreateCall(mallocFunc, classNameLength);
+  recordHeapBytes("String", classNameLength);
   builder->CreateMemCpy(newStrMemory, stdAlign, className, stdAlign, classNameLength);
 
   auto* newIntObject = createNewClassInstanceOnHeap("Int");
@@ -204,6 +266,9 @@ void BuiltinMethodsBuilder::genIOOutString() {
   auto* coolObjectPtrType = getPtrType("Object");
 
   auto methodName = getMethodName("IO", "out_string");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -229,6 +294,9 @@ void BuiltinMethodsBuilder::genIOOutInt() {
   auto* coolObjPtrType = getPtrType("Object");
 
   auto methodName = getMethodName("IO", "out_int");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -255,6 +323,9 @@ void BuiltinMethodsBuilder::genIOOutInt() {
 
 void BuiltinMethodsBuilder::genIOInInt() {
   auto methodName = getMethodName("IO", "in_int");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -303,6 +374,9 @@ void BuiltinMethodsBuilder::genIOInInt() {
 
 void BuiltinMethodsBuilder::genIOInString() {
   auto methodName = getMethodName("IO", "in_string");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -352,6 +426,7 @@ void BuiltinMethodsBuilder::genIOInString() {
   builder->CreateStore(castedStringLength, intValueAddress);
 
   auto* stringMemory = builder->CreateCall(mallocFunc, stringLength);
+  recordHeapBytes("String", stringLength);
   builder->CreateMemCpy(stringMemory, stdAlign, buffer, stdAlign, stringLength);
   auto* freeFunc = module->getFunction("free");
   assert(freeFunc != nullptr);
@@ -369,6 +444,9 @@ void BuiltinMethodsBuilder::genIOInString() {
 
 void BuiltinMethodsBuilder::genStringLength() {
   auto methodName = getMethodName("String", "length");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -382,6 +460,7 @@ void BuiltinMethodsBuilder::genStringLength() {
   auto* objPtrType = getPtrType("Object");
   auto copyObjFuncName = getMethodName("Object", "copy");
   auto* copyObjFunc = module->getFunction(copyObjFuncName);
+  setAllocationSite();
   auto* newIntObj =
       builder->CreateCall(copyObjFunc, builder->CreateBitCast(stringSizeObj, objPtrType));
   builder->CreateRet(builder->CreateBitCast(newIntObj, getPtrType("Int")));
@@ -390,6 +469,9 @@ void BuiltinMethodsBuilder::genStringLength() {
 
 void BuiltinMethodsBuilder::genStringConcat() {
   auto methodName = getMethodName("String", "concat");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -414,22 +496,33 @@ void BuiltinMethodsBuilder::genStringConcat() {
   auto* mallocFunc = module->getFunction("malloc");
   assert(mallocFunc != nullptr);
   auto* systemSizeType = env.getSystemType(Environment::SystemType::SizeType);
-  auto* stringMemory =
-      builder->CreateCall(mallocFunc, builder->CreateSExt(resultStringSize, systemSizeType));
+  auto* stringMemorySize = builder->CreateSExt(resultStringSize, systemSizeType);
+  auto* augmentedStringSize = builder->CreateAdd(stringMemorySize, builder->getInt64(1));
+  auto* stringMemory = builder->CreateCall(mallocFunc, augmentedStringSize);
+  recordHeapBytes("String", augmentedStringSize);
 
+  // the second string is placed right after the first one, thus it is not aligned
   address = builder->CreateGEP(firstStringObjPtr, getGepIndices({0, 5}));
   auto* firstStringMemory = builder->CreateLoad(address);
   builder->CreateMemCpy(stringMemory, stdAlign, firstStringMemory, stdAlign, firstStringSize);
 
-  auto* strcatFunc = module->getFunction("strcat");
-  assert(strcatFunc != nullptr);
   address = builder->CreateGEP(secondStringObjPtr, getGepIndices({0, 5}));
   auto* secondStringMemory = builder->CreateLoad(address);
-  builder->CreateCall(strcatFunc, {stringMemory, secondStringMemory});
+  auto* secondStringStart = builder->CreateInBoundsGEP(stringMemory, firstStringSize);
+  builder->CreateMemCpy(
+      secondStringStart, llvm::Align(1), secondStringMemory, stdAlign, secondStringSize);
 
-  auto* newStringObj = createNewClassInstanceOnHeap("String");
-  address = getStringSizeAddress(newStringObj);
+  auto* stringEnd = builder->CreateInBoundsGEP(stringMemory, stringMemorySize);
+  builder->CreateStore(builder->getInt8(static_cast<uint8_t>('\0')), stringEnd);
+
+  // a new string shares the length object of its prototype, thus it gets an object of its own
+  auto* newIntObj = createNewClassInstanceOnHeap("Int");
+  address = builder->CreateGEP(newIntObj, getGepIndices({0, 4}));
   builder->CreateStore(resultStringSize, address);
+
+  auto* newStringObj = createNewClassInstanceOnHeap("String");
+  auto* stringSizeAddress = builder->CreateGEP(newStringObj, getGepIndices({0, 4}));
+  builder->CreateStore(newIntObj, stringSizeAddress);
   auto* stringMemoryAddress = builder->CreateGEP(newStringObj, getGepIndices({0, 5}));
   builder->CreateStore(stringMemory, stringMemoryAddress);
 
@@ -439,6 +532,9 @@ void BuiltinMethodsBuilder::genStringConcat() {
 
 void BuiltinMethodsBuilder::genStringSubstr() {
   auto methodName = getMethodName("String", "substr");
+  if (not env.isLiveFunction(methodName)) {
+    return;
+  }
   auto* function = module->getFunction(methodName);
   assert(function != nullptr);
 
@@ -459,6 +555,7 @@ void BuiltinMethodsBuilder::genStringSubstr() {
   stringSize = builder->CreateSExt(stringSize, systemSizeType);
   auto* augmentedStringSize = builder->CreateAdd(stringSize, builder->getInt64(1));
   auto* stringMemory = builder->CreateCall(mallocFunc, augmentedStringSize);
+  recordHeapBytes("String", augmentedStringSize);
 
   constexpr auto nullChar = static_cast<uint8_t>('\0');
   builder->CreateMemSet(stringMemory, builder->getInt8(nullChar), augmentedStringSize, stdAlign);
@@ -486,25 +583,20 @@ void BuiltinMethodsBuilder::genStringSubstr() {
   llvm::verifyFunction(*function, &(llvm::errs()));
 }
 
-void BuiltinMethodsBuilder::genNullPtrCheck() {
+void BuiltinMethodsBuilder::genNullPtrAbort() {
   auto* voidType = llvm::Type::getVoidTy(*context);
-  auto* objPtrType = getPtrType("Object");
-  auto* funcType = llvm::FunctionType::get(voidType, {objPtrType}, false);
+  auto* funcType = llvm::FunctionType::get(voidType, false);
   auto* function = llvm::Function::Create(
-      funcType, llvm::Function::ExternalLinkage, "_assert_not_nullptr", *module);
+      funcType, llvm::Function::InternalLinkage, "_abort_on_nullptr", *module);
   function->setCallingConv(llvm::CallingConv::C);
+  function->setDoesNotReturn();
+  function->setDoesNotThrow();
+  function->addFnAttr(llvm::Attribute::Cold);
+  function->addFnAttr(llvm::Attribute::NoInline);
 
   auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
-  auto* abortBB = llvm::BasicBlock::Create(*context);
-  auto* exitBB = llvm::BasicBlock::Create(*context);
-
   builder->SetInsertPoint(entryBB);
-  auto* nullPtr = llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(objPtrType));
-  auto* result = builder->CreateICmpEQ(function->getArg(0), nullPtr);
-  builder->CreateCondBr(result, abortBB, exitBB);
 
-  function->getBasicBlockList().push_back(abortBB);
-  builder->SetInsertPoint(abortBB);
   auto* printfFunc = module->getFunction("printf");
   assert(printfFunc != nullptr);
   auto* errorMsg =
@@ -514,11 +606,8 @@ void BuiltinMethodsBuilder::genNullPtrCheck() {
   auto* abortFunc = module->getFunction("exit");
   assert(abortFunc != nullptr);
   builder->CreateCall(abortFunc, builder->getInt32(-1));
-  builder->CreateRet(nullptr);
-
-  function->getBasicBlockList().push_back(exitBB);
-  builder->SetInsertPoint(exitBB);
-  builder->CreateRet(nullptr);
+  builder->CreateUnreachable();
+  llvm::verifyFunction(*function, &(llvm::errs()));
 }
 
 } // namespace mcool::codegen
\ No newline at end of file
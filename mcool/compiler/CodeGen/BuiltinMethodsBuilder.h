@@ -21,7 +21,7 @@ class BuiltinMethodsBuilder : public BaseBuilder {
   void genStringLength();
   void genStringConcat();
   void genStringSubstr();
-  void genNullPtrCheck();
+  void genNullPtrAbort();
 };
 
 } // namespace mcool::codegen
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "CodeGen/CallProfileBuilder.h"
+#include "CodeGen/Misc.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/Verifier.h"
+
+namespace mcool::codegen {
+namespace {
+enum RecordField { Name = 0, Calls, SelfCycles, InclusiveCycles, Depth };
+} // namespace
+
+CallProfileBuilder::Activation CallProfileBuilder::genEntry(llvm::Function* function) {
+  auto* recordType = getRecordType();
+  auto* name = builder->CreateGlobalStringPtr(function->getName(), "", 0, module.get());
+  auto* initializer = llvm::ConstantStruct::get(recordType,
+                                                {llvm::cast<llvm::Constant>(name),
+                                                 builder->getInt64(0),
+                                                 builder->getInt64(0),
+                                                 builder->getInt64(0),
+                                                 builder->getInt64(0)});
+  auto* record = new llvm::GlobalVariable(*module,
+                                          recordType,
+                                          false,
+                                          llvm::GlobalValue::PrivateLinkage,
+                                          initializer,
+                                          getCallRecordName(function->getName().str()));
+  env.callRecords.push_back(record);
+
+  auto increment = [this, record](RecordField field) {
+    auto* address = builder->CreateStructGEP(record, field);
+    builder->CreateStore(builder->CreateAdd(builder->CreateLoad(address), builder->getInt64(1)),
+                         address);
+  };
+  increment(Calls);
+  increment(Depth);
+
+  auto* childCycles = getChildCycles();
+  auto* savedChildCycles = builder->CreateLoad(childCycles);
+  builder->CreateStore(builder->getInt64(0), childCycles);
+
+  auto* readCycleCounter =
+      llvm::Intrinsic::getDeclaration(module.get(), llvm::Intrinsic::readcyclecounter);
+  auto* startCycles = builder->CreateCall(readCycleCounter);
+  return Activation{record, startCycles, savedChildCycles};
+}
+
+// the cycles of an activation are added to the child cycles of its caller
+void CallProfileBuilder::genExit(const Activation& activation) {
+  auto* readCycleCounter =
+      llvm::Intrinsic::getDeclaration(module.get(), llvm::Intrinsic::readcyclecounter);
+  auto* cycles = builder->CreateSub(builder->CreateCall(readCycleCounter), activation.startCycles);
+
+  auto* childCycles = getChildCycles();
+  auto* selfCycles = builder->CreateSub(cycles, builder->CreateLoad(childCycles));
+  auto* selfAddress = builder->CreateStructGEP(activation.record, SelfCycles);
+  builder->CreateStore(builder->CreateAdd(builder->CreateLoad(selfAddress), selfCycles),
+                       selfAddress);
+
+  auto* depthAddress = builder->CreateStructGEP(activation.record, Depth);
+  auto* depth = builder->CreateSub(builder->CreateLoad(depthAddress), builder->getInt64(1));
+  builder->CreateStore(depth, depthAddress);
+  auto* isOutermost = builder->CreateICmpEQ(depth, builder->getInt64(0));
+  auto* inclusiveCycles = builder->CreateSelect(isOutermost, cycles, builder->getInt64(0));
+  auto* inclusiveAddress = builder->CreateStructGEP(activation.record, InclusiveCycles);
+  builder->CreateStore(builder->CreateAdd(builder->CreateLoad(inclusiveAddress), inclusiveCycles),
+                       inclusiveAddress);
+
+  builder->CreateStore(builder->CreateAdd(activation.savedChildCycles, cycles), childCycles);
+}
+
+// writes records of called methods sorted by their self time
+void CallProfileBuilder::genProfileWriter() {
+  auto* recordPtrType = getRecordType()->getPointerTo();
+  auto numRecords = env.callRecords.size();
+  auto* recordsType = llvm::ArrayType::get(recordPtrType, numRecords);
+  llvm::SmallVector<llvm::Constant*> recordPtrs(env.callRecords.begin(), env.callRecords.end());
+  auto* records = new llvm::GlobalVariable(*module,
+                                           recordsType,
+                                           false,
+                                           llvm::GlobalValue::PrivateLinkage,
+                                           llvm::ConstantArray::get(recordsType, recordPtrs),
+                                           getCallRecordsName());
+
+  auto* comparator = genRecordComparator();
+  auto* funcType = llvm::FunctionType::get(builder->getVoidTy(), {}, false);
+  auto* function = llvm::Function::Create(
+      funcType, llvm::Function::PrivateLinkage, getCallProfileWriterName(), *module);
+
+  auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
+  auto* headerBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* loopBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* recordBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* writeBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* incrementBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* closeBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* exitBB = llvm::BasicBlock::Create(*context, "", function);
+
+  builder->SetInsertPoint(entryBB);
+  auto* bytePtrType = env.getSystemType(Environment::SystemType::BytePtrType);
+  auto* recordPtrSize = builder->getInt64(module->getDataLayout().getTypeAllocSize(recordPtrType));
+  auto* qsortFunc = module->getFunction("qsort");
+  assert(qsortFunc != nullptr);
+  builder->CreateCall(qsortFunc,
+                      {builder->CreateBitCast(records, bytePtrType),
+                       builder->getInt64(numRecords),
+                       recordPtrSize,
+                       comparator});
+
+  auto& profileFile = env.coolConfig.callProfileFile;
+  auto* fileName = builder->CreateGlobalStringPtr(profileFile, "", 0, module.get());
+  auto* mode = builder->CreateGlobalStringPtr("w", "", 0, module.get());
+  auto* fopenFunc = module->getFunction("fopen");
+  assert(fopenFunc != nullptr);
+  auto* file = builder->CreateCall(fopenFunc, {fileName, mode});
+  auto* filePtrType = llvm::cast<llvm::PointerType>(file->getType());
+  auto* isNull = builder->CreateICmpEQ(file, llvm::ConstantPointerNull::get(filePtrType));
+  builder->CreateCondBr(isNull, exitBB, headerBB);
+
+  builder->SetInsertPoint(headerBB);
+  auto* fprintfFunc = module->getFunction("fprintf");
+  assert(fprintfFunc != nullptr);
+  auto* header = builder->CreateGlobalStringPtr(
+      "#        calls      self-cycles inclusive-cycles  method\n", "", 0, module.get());
+  builder->CreateCall(fprintfFunc, {file, header});
+  builder->CreateBr(loopBB);
+
+  builder->SetInsertPoint(loopBB);
+  auto* index = builder->CreatePHI(builder->getInt64Ty(), 2);
+  index->addIncoming(builder->getInt64(0), headerBB);
+  auto* isDone = builder->CreateICmpEQ(index, builder->getInt64(numRecords));
+  builder->CreateCondBr(isDone, closeBB, recordBB);
+
+  builder->SetInsertPoint(recordBB);
+  auto* recordAddress = builder->CreateInBoundsGEP(records, {builder->getInt64(0), index});
+  auto* record = builder->CreateLoad(recordAddress);
+  auto loadField = [this, record](RecordField field) {
+    return builder->CreateLoad(builder->CreateStructGEP(record, field));
+  };
+  auto* calls = loadField(Calls);
+  auto* isCalled = builder->CreateICmpNE(calls, builder->getInt64(0));
+  builder->CreateCondBr(isCalled, writeBB, incrementBB);
+
+  builder->SetInsertPoint(writeBB);
+  auto* format = builder->CreateGlobalStringPtr("%14lu %16lu %16lu  %s\n", "", 0, module.get());
+  builder->CreateCall(
+      fprintfFunc,
+      {file, format, calls, loadField(SelfCycles), loadField(InclusiveCycles), loadField(Name)});
+  builder->CreateBr(incrementBB);
+
+  builder->SetInsertPoint(incrementBB);
+  index->addIncoming(builder->CreateAdd(index, builder->getInt64(1)), incrementBB);
+  builder->CreateBr(loopBB);
+
+  builder->SetInsertPoint(closeBB);
+  auto* fcloseFunc = module->getFunction("fclose");
+  assert(fcloseFunc != nullptr);
+  builder->CreateCall(fcloseFunc, file);
+  builder->CreateBr(exitBB);
+
+  builder->SetInsertPoint(exitBB);
+  builder->CreateRetVoid();
+  llvm::verifyFunction(*function, &(llvm::errs()));
+}
+
+llvm::StructType* CallProfileBuilder::getRecordType() {
+  auto* recordType = llvm::StructType::getTypeByName(*context, getCallRecordTypeName());
+  if (recordType == nullptr) {
+    auto* charPtrType = env.getSystemType(Environment::SystemType::CharPtrType);
+    auto* counterType = builder->getInt64Ty();
+    recordType = llvm::StructType::create(
+        *context,
+        {charPtrType, counterType, counterType, counterType, counterType},
+        getCallRecordTypeName());
+  }
+  return recordType;
+}
+
+// cycles spent in callees of the current activation
+llvm::GlobalVariable* CallProfileBuilder::getChildCycles() {
+  auto* childCycles = module->getGlobalVariable(getCallChildCyclesName(), true);
+  if (childCycles == nullptr) {
+    childCycles = new llvm::GlobalVariable(*module,
+                                           builder->getInt64Ty(),
+                                           false,
+                                           llvm::GlobalValue::PrivateLinkage,
+                                           builder->getInt64(0),
+                                           getCallChildCyclesName());
+  }
+  return childCycles;
+}
+
+// orders records by self cycles, then by inclusive cycles and calls; the greatest come first
+llvm::Function* CallProfileBuilder::genRecordComparator() {
+  auto* bytePtrType = env.getSystemType(Environment::SystemType::BytePtrType);
+  auto* funcType =
+      llvm::FunctionType::get(builder->getInt32Ty(), {bytePtrType, bytePtrType}, false);
+  auto* function = llvm::Function::Create(
+      funcType, llvm::Function::PrivateLinkage, "_compare_call_records", *module);
+
+  auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
+  builder->SetInsertPoint(entryBB);
+
+  auto* recordPtrPtrType = getRecordType()->getPointerTo()->getPointerTo();
+  auto* first = builder->CreateLoad(builder->CreateBitCast(function->getArg(0), recordPtrPtrType));
+  auto* second =
+      builder->CreateLoad(builder->CreateBitCast(function->getArg(1), recordPtrPtrType));
+
+  llvm::Value* result = builder->getInt32(0);
+  for (auto field : {SelfCycles, InclusiveCycles, Calls}) {
+    auto* firstValue = builder->CreateLoad(builder->CreateStructGEP(first, field));
+    auto* secondValue = builder->CreateLoad(builder->CreateStructGEP(second, field));
+    auto* isLess = builder->CreateZExt(
+        builder->CreateICmpULT(firstValue, secondValue), builder->getInt32Ty());
+    auto* isGreater = builder->CreateZExt(
+        builder->CreateICmpUGT(firstValue, secondValue), builder->getInt32Ty());
+    auto* order = builder->CreateSub(isLess, isGreater);
+    auto* isOrdered = builder->CreateICmpNE(result, builder->getInt32(0));
+    result = builder->CreateSelect(isOrdered, result, order);
+  }
+  builder->CreateRet(result);
+  llvm::verifyFunction(*function, &(llvm::errs()));
+  return function;
+}
+} // namespace mcool::codegen
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CodeGen/BaseBuilder.h"
+
+namespace mcool::codegen {
+// Instruments generated methods with call counters and cycle timers, see `--instrument-calls`.
+// Self time of a method excludes the time of its callees; inclusive time of a recursive
+// method is accounted for its outermost activation only.
+class CallProfileBuilder : public BaseBuilder {
+  public:
+  struct Activation {
+    llvm::Value* record{};
+    llvm::Value* startCycles{};
+    llvm::Value* savedChildCycles{};
+  };
+
+  explicit CallProfileBuilder(Environment& env) : BaseBuilder(env) {}
+
+  bool isEnabled() { return not env.coolConfig.callProfileFile.empty(); }
+  Activation genEntry(llvm::Function* function);
+  void genExit(const Activation& activation);
+  void genProfileWriter();
+
+  private:
+  llvm::StructType* getRecordType();
+  llvm::GlobalVariable* getChildCycles();
+  llvm::Function* genRecordComparator();
+};
+} // namespace mcool::codegen
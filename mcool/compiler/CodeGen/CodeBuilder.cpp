@@ -1,8 +1,34 @@
 #include "CodeGen/CodeBuilder.h"
 #include "CodeGen/Misc.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Verifier.h"
+#include <algorithm>
+#include <limits>
+#include <optional>
 
 namespace mcool::codegen {
+namespace {
+// the number of SIGUSR1 differs between BSD-derived systems and Linux, and between the
+// architectures of Linux
+std::optional<int> getUserSignalNumber(const llvm::Triple& triple) {
+  if (triple.isOSDarwin() || triple.isOSFreeBSD() || triple.isOSNetBSD() ||
+      triple.isOSOpenBSD()) {
+    return 30;
+  }
+  if (triple.isOSLinux()) {
+    if (triple.isMIPS()) {
+      return 16;
+    }
+    auto arch = triple.getArch();
+    bool isSparc = (arch == llvm::Triple::sparc) || (arch == llvm::Triple::sparcv9) ||
+                   (arch == llvm::Triple::sparcel);
+    return isSparc ? 30 : 10;
+  }
+  return std::nullopt;
+}
+} // namespace
+
 void CodeBuilder::callParentsConstructors(llvm::Value* objPtr,
                                           std::vector<type::Graph::Node*>& inheritanceChain) {
   inheritanceChain.erase(inheritanceChain.begin());
@@ -29,15 +55,20 @@ void CodeBuilder::genConstructors(mcool::AstTree& classes) {
     currSymbolTable = codegen::SymbolTable{};
 
     auto constructorName = getConstructorName(currClassName);
+    if (not env.isLiveFunction(constructorName)) {
+      continue;
+    }
     auto* constructor = module->getFunction(constructorName);
 
     llvm::BasicBlock* BB = llvm::BasicBlock::Create(*context, "entry", constructor);
     builder->SetInsertPoint(BB);
+    debugInfoBuilder.genSubprogram(constructor, coolClass);
 
     llvm::Value* selfPtr = constructor->getArg(0);
     llvm::Value* selfPtrAddress = genAlloca(selfPtr->getType());
     builder->CreateStore(selfPtr, selfPtrAddress);
-    currSymbolTable.add("self", selfPtrAddress);
+    currSymbolTable.add(selfId, selfPtrAddress);
+    debugInfoBuilder.declareVariable(selfPtrAddress, "self", currClassName, coolClass, 1);
 
     {
       auto &graph = env.coolContext.getInheritanceGraph();
@@ -50,20 +81,184 @@ void CodeBuilder::genConstructors(mcool::AstTree& classes) {
       bool isIntegralType = (currClassName == "Bool") || (currClassName == "Int");
       if (not isIntegralType) {
         auto &membersTable = env.globalMembersTable[currClassName];
-        auto &topScope = membersTable.getTopScope();
+        auto topScope = membersTable.getTopScope();
         for (auto &item: topScope) {
-          assert(item->member != nullptr);
-          item->member->accept(this);
+          assert(item.value.member != nullptr);
+          item.value.member->accept(this);
           popStack();
         }
       }
     }
 
     builder->CreateRet(constructor->getArg(0));
+    debugInfoBuilder.finalizeSubprogram(constructor);
     llvm::verifyFunction(*constructor, &(llvm::errs()));
   }
 }
 
+std::string CodeBuilder::getDispatchSiteName() {
+  auto functionName = builder->GetInsertBlock()->getParent()->getName().str();
+  auto ordinal = numDispatchSites[functionName]++;
+  return functionName + "#" + std::to_string(ordinal);
+}
+
+void CodeBuilder::genReceiverCounting(llvm::Value* objPtr, const std::string& siteName) {
+  auto* countersType = llvm::ArrayType::get(builder->getInt64Ty(), env.classTagTable.size());
+  auto* counters = new llvm::GlobalVariable(*module,
+                                            countersType,
+                                            false,
+                                            llvm::GlobalValue::PrivateLinkage,
+                                            llvm::ConstantAggregateZero::get(countersType),
+                                            getReceiverCountersName());
+  env.instrumentedDispatchSites.push_back(InstrumentedDispatchSite{siteName, counters});
+
+  auto* castedObjPtr = builder->CreateBitCast(objPtr, getPtrType("Object"));
+  auto* classTagAddress = builder->CreateGEP(castedObjPtr, getGepIndices({0, 1}));
+  auto* classTag = builder->CreateLoad(classTagAddress);
+
+  auto* counterAddress = builder->CreateInBoundsGEP(counters, {builder->getInt32(0), classTag});
+  auto* count = builder->CreateLoad(counterAddress);
+  builder->CreateStore(builder->CreateAdd(count, builder->getInt64(1)), counterAddress);
+}
+
+void CodeBuilder::genReceiverCheck(llvm::Value* objPtr, ast::Node* node) {
+  if (env.nonVoidReceivers.count(node) == 0) {
+    assertNotNullptr(objPtr);
+    return;
+  }
+  emitRemark<llvm::OptimizationRemark>(
+      "mcool-nullness", "NullCheckElided", "null check removed, the receiver is never void");
+}
+
+// implementations which receive at least `minTargetPercentage` of all profiled receivers
+std::vector<CodeBuilder::SpeculativeTarget> CodeBuilder::getSpeculativeTargets(
+    const std::string& siteName, const std::string& methodName, uint64_t& numOtherReceivers) {
+  constexpr size_t maxNumTargets{2};
+  constexpr uint64_t minTargetPercentage{30};
+
+  std::vector<SpeculativeTarget> targets{};
+  auto it = env.receiverProfile.find(siteName);
+  if (it == env.receiverProfile.end()) {
+    return targets;
+  }
+
+  uint64_t numReceivers{0};
+  std::unordered_map<std::string, uint64_t> implementationCounts{};
+  auto methodId = getSymbolId(methodName);
+  for (auto& [className, count] : it->second) {
+    numReceivers += count;
+    auto methodsTable = env.globalMethodsTable.find(className);
+    if (methodsTable == env.globalMethodsTable.end()) {
+      continue;
+    }
+    auto data = methodsTable->second.lookup(methodId);
+    if (data.has_value()) {
+      implementationCounts[getImplementationName(className, data.value())] += count;
+    }
+  }
+
+  numOtherReceivers = numReceivers;
+  for (auto& [implementationName, count] : implementationCounts) {
+    auto* function = module->getFunction(implementationName);
+    bool isHot = (count * 100) >= (numReceivers * minTargetPercentage);
+    if (isHot && (function != nullptr) && env.isLiveFunction(implementationName)) {
+      targets.push_back(SpeculativeTarget{function, count});
+    }
+  }
+
+  std::sort(targets.begin(), targets.end(), [](auto& first, auto& second) {
+    if (first.count != second.count) {
+      return first.count > second.count;
+    }
+    return first.function->getName() < second.function->getName();
+  });
+  if (targets.size() > maxNumTargets) {
+    targets.resize(maxNumTargets);
+  }
+
+  for (auto& target : targets) {
+    numOtherReceivers -= target.count;
+  }
+  return targets;
+}
+
+// compares the loaded dispatch table slot against the expected implementations and calls
+// them directly, so that LLVM can inline them; other receivers take the indirect call
+llvm::Value* CodeBuilder::genSpeculativeCall(llvm::Value* callee,
+                                             llvm::ArrayRef<llvm::Value*> args,
+                                             const std::vector<SpeculativeTarget>& targets,
+                                             uint64_t numOtherReceivers,
+                                             const MethodEffects& effects) {
+  auto* calleePtrType = llvm::cast<llvm::PointerType>(callee->getType());
+  auto* calleeFunctionType = llvm::cast<llvm::FunctionType>(calleePtrType->getElementType());
+  auto* returnType = calleeFunctionType->getReturnType();
+
+  // branch weights are 32-bit wide
+  uint64_t maxCount = numOtherReceivers;
+  for (auto& target : targets) {
+    maxCount = std::max(maxCount, target.count);
+  }
+  unsigned shift{0};
+  while ((maxCount >> shift) > std::numeric_limits<uint32_t>::max()) {
+    ++shift;
+  }
+
+  uint64_t numRemainingReceivers = numOtherReceivers;
+  for (auto& target : targets) {
+    numRemainingReceivers += target.count;
+  }
+  for (auto& target : targets) {
+    emitRemark<llvm::OptimizationRemark>("mcool-devirt",
+                                         "Speculated",
+                                         "dispatch speculated to call ",
+                                         llvm::ore::NV("Callee", target.function),
+                                         " for ",
+                                         llvm::ore::NV("Count", target.count),
+                                         " of ",
+                                         llvm::ore::NV("NumReceivers", numRemainingReceivers),
+                                         " profiled receivers");
+  }
+
+  auto* parentFunction = builder->GetInsertBlock()->getParent();
+  auto* mergeBB = llvm::BasicBlock::Create(*context);
+  llvm::MDBuilder mdBuilder(*context);
+  std::vector<std::pair<llvm::Value*, llvm::BasicBlock*>> results{};
+  for (auto& target : targets) {
+    auto* directCallBB = llvm::BasicBlock::Create(*context, "", parentFunction);
+    auto* nextBB = llvm::BasicBlock::Create(*context, "", parentFunction);
+
+    numRemainingReceivers -= target.count;
+    auto* expectedCallee = builder->CreateBitCast(target.function, calleePtrType);
+    auto* isExpected = builder->CreateICmpEQ(callee, expectedCallee);
+    auto* weights = mdBuilder.createBranchWeights(target.count >> shift,
+                                                  numRemainingReceivers >> shift);
+    builder->CreateCondBr(isExpected, directCallBB, nextBB, weights);
+
+    builder->SetInsertPoint(directCallBB);
+    llvm::SmallVector<llvm::Value*> directArgs(args.begin(), args.end());
+    directArgs[0] = builder->CreateBitCast(args[0], target.function->getArg(0)->getType());
+    auto* directResult = builder->CreateCall(target.function, directArgs);
+    addEffectAttributes(directResult, effects);
+    results.push_back({builder->CreateBitCast(directResult, returnType), directCallBB});
+    builder->CreateBr(mergeBB);
+
+    builder->SetInsertPoint(nextBB);
+  }
+
+  auto* indirectResult = builder->CreateCall(calleeFunctionType, callee, args);
+  addEffectAttributes(indirectResult, effects);
+  results.push_back({indirectResult, builder->GetInsertBlock()});
+  builder->CreateBr(mergeBB);
+
+  parentFunction->getBasicBlockList().push_back(mergeBB);
+  builder->SetInsertPoint(mergeBB);
+  auto* result = builder->CreatePHI(returnType, results.size());
+  for (auto& [value, block] : results) {
+    result->addIncoming(value, block);
+  }
+  return result;
+}
+
 void CodeBuilder::generatedMainEntryPoint() {
   auto* intType = llvm::Type::getInt32Ty(*context);
   auto* funcType = llvm::FunctionType::get(intType, {}, false);
@@ -72,6 +267,26 @@ void CodeBuilder::generatedMainEntryPoint() {
 
   llvm::BasicBlock* BB = llvm::BasicBlock::Create(*context, "entry", function);
   builder->SetInsertPoint(BB);
+  debugInfoBuilder.genSubprogram(function, nullptr);
+
+  for (auto* writerName :
+       {getReceiverProfileWriterName(), getCallProfileWriterName(), getHeapProfileWriterName()}) {
+    auto* profileWriter = module->getFunction(writerName);
+    if (profileWriter != nullptr) {
+      auto* atexitFunc = module->getFunction("atexit");
+      assert(atexitFunc != nullptr);
+      builder->CreateCall(atexitFunc, profileWriter);
+    }
+  }
+
+  // targets without SIGUSR1 only write the profile at exit
+  auto* signalHandler = module->getFunction(getHeapProfileSignalHandlerName());
+  auto userSignal = getUserSignalNumber(llvm::Triple(module->getTargetTriple()));
+  if ((signalHandler != nullptr) && userSignal.has_value()) {
+    auto* signalFunc = module->getFunction("signal");
+    assert(signalFunc != nullptr);
+    builder->CreateCall(signalFunc, {builder->getInt32(userSignal.value()), signalHandler});
+  }
 
   auto* coolMainPtrType = getPtrType("Main");
   auto* coolObjectPtrType = getPtrType("Object");
@@ -85,6 +300,7 @@ void CodeBuilder::generatedMainEntryPoint() {
   assert(objCopyMethod != nullptr);
 
   auto* objPtr = builder->CreateBitCast(protoMain, coolObjectPtrType);
+  setAllocationSite();
   auto* newObjPtr = builder->CreateCall(objCopyMethod, objPtr);
   auto* newMainPtr = builder->CreateBitCast(newObjPtr, coolMainPtrType);
 
@@ -100,6 +316,7 @@ void CodeBuilder::generatedMainEntryPoint() {
 
   auto* zero = llvm::Constant::getIntegerValue(intType, llvm::APInt(32, 0));
   builder->CreateRet(zero);
+  debugInfoBuilder.finalizeSubprogram(function);
   llvm::verifyFunction(*function, &(llvm::errs()));
 }
 } // namespace mcool::codegen
\ No newline at end of file
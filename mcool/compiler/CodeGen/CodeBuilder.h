@@ -2,12 +2,19 @@
 
 #include "visitor.h"
 #include "CodeGen/BaseBuilder.h"
+#include "CodeGen/DebugInfoBuilder.h"
+#include "CodeGen/CallProfileBuilder.h"
 #include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace mcool::codegen {
 class CodeBuilder : public BaseBuilder, public ast::Visitor {
   public:
-  explicit CodeBuilder(Environment& env) : BaseBuilder(env) {}
+  explicit CodeBuilder(Environment& env)
+      : BaseBuilder(env), debugInfoBuilder(env), callProfileBuilder(env),
+        selfId(getSymbolId("self")) {}
 
   void genConstructors(mcool::AstTree& classes);
   void genMethods(mcool::AstTree& classes);
@@ -57,6 +64,23 @@ class CodeBuilder : public BaseBuilder, public ast::Visitor {
   void callParentsConstructors(llvm::Value* objPtr,
                                std::vector<type::Graph::Node*>& inheritanceChain);
 
+  struct SpeculativeTarget {
+    llvm::Function* function{};
+    uint64_t count{0};
+  };
+
+  void genReceiverCheck(llvm::Value* objPtr, ast::Node* node);
+  std::string getDispatchSiteName();
+  void genReceiverCounting(llvm::Value* objPtr, const std::string& siteName);
+  std::vector<SpeculativeTarget> getSpeculativeTargets(const std::string& siteName,
+                                                       const std::string& methodName,
+                                                       uint64_t& numOtherReceivers);
+  llvm::Value* genSpeculativeCall(llvm::Value* callee,
+                                  llvm::ArrayRef<llvm::Value*> args,
+                                  const std::vector<SpeculativeTarget>& targets,
+                                  uint64_t numOtherReceivers,
+                                  const MethodEffects& effects);
+
   llvm::Value* popStack() {
     auto* value = stack.back();
     stack.pop_back();
@@ -65,8 +89,13 @@ class CodeBuilder : public BaseBuilder, public ast::Visitor {
 
   std::deque<llvm::Value*> stack;
   std::string currClassName{};
+  std::string exactSelfClassName{};
   SymbolTable currSymbolTable{};
   llvm::Function* currLLVMFunction{};
   llvm::PointerType* currFuncReturnType{};
+  std::unordered_map<std::string, unsigned> numDispatchSites{};
+  DebugInfoBuilder debugInfoBuilder;
+  CallProfileBuilder callProfileBuilder;
+  SymbolId selfId;
 };
 } // namespace mcool::codegen
\ No newline at end of file
@@ -20,14 +20,30 @@ void CodeBuilder::visitCoolClass(ast::CoolClass* coolClass) {
   bool isDefaultClass = defaultClasses.find(currClassName) != defaultClasses.end();
   if (not isDefaultClass) {
     for (auto* attr : coolClass->getAttributes()->getData()) {
-      if (auto* coolMethod = dynamic_cast<ast::SingleMethod*>(attr)) {
+      auto* coolMethod = llvm::dyn_cast<ast::SingleMethod>(attr);
+      if (coolMethod == nullptr) {
+        continue;
+      }
+      auto methodName = getMethodName(currClassName, coolMethod->getId()->getNameAsStr());
+      if (env.isLiveFunction(methodName)) {
         coolMethod->accept(this);
       }
     }
+
+    // a clone is compiled in the scope of the class which defines the method
+    auto receiverClassName = currClassName;
+    for (auto& [_, customized] : env.customizedMethods[receiverClassName]) {
+      currClassName = customized.owner->getCoolType()->getNameAsStr();
+      exactSelfClassName = receiverClassName;
+      customized.method->accept(this);
+    }
+    currClassName = receiverClassName;
+    exactSelfClassName.clear();
   }
 }
 
 void CodeBuilder::visitSingleMember(ast::SingleMember* member) {
+  ScopedDebugLocation location(debugInfoBuilder, member);
   getLObjValue(member->getId());
   auto* idAddress = popStack();
   assert(idAddress != nullptr);
@@ -56,17 +72,35 @@ void CodeBuilder::visitSingleMember(ast::SingleMember* member) {
 
 void CodeBuilder::visitSingleMethod(ast::SingleMethod* coolMethod) {
   auto& idName = coolMethod->getId()->getNameAsStr();
-  auto methodName = getMethodName(currClassName, idName);
+  auto& selfClassName = exactSelfClassName.empty() ? currClassName : exactSelfClassName;
+  auto methodName = getMethodName(selfClassName, idName);
   currLLVMFunction = module->getFunction(methodName);
 
   llvm::BasicBlock* BB = llvm::BasicBlock::Create(*context, "entry", currLLVMFunction);
   builder->SetInsertPoint(BB);
+  debugInfoBuilder.genSubprogram(currLLVMFunction, coolMethod);
+  if (not exactSelfClassName.empty()) {
+    emitRemark<llvm::OptimizationRemark>("mcool-customize",
+                                         "Customized",
+                                         llvm::ore::NV("Method", idName),
+                                         " of ",
+                                         llvm::ore::NV("Owner", currClassName),
+                                         " customized for receiver class ",
+                                         llvm::ore::NV("Class", exactSelfClassName));
+  }
+
+  CallProfileBuilder::Activation activation{};
+  if (callProfileBuilder.isEnabled()) {
+    activation = callProfileBuilder.genEntry(currLLVMFunction);
+  }
 
   currSymbolTable = codegen::SymbolTable{};
-  llvm::Value* selfPtr = currLLVMFunction->getArg(0);
+  auto* selfPtrType = getPtrType(currClassName);
+  llvm::Value* selfPtr = builder->CreateBitCast(currLLVMFunction->getArg(0), selfPtrType);
   llvm::Value* selfPtrAddress = genAlloca(selfPtr->getType());
   builder->CreateStore(selfPtr, selfPtrAddress);
-  currSymbolTable.add("self", selfPtrAddress);
+  currSymbolTable.add(selfId, selfPtrAddress);
+  debugInfoBuilder.declareVariable(selfPtrAddress, "self", selfClassName, coolMethod, 1);
 
   coolMethod->getParameters()->accept(this);
 
@@ -79,7 +113,11 @@ void CodeBuilder::visitSingleMethod(ast::SingleMethod* coolMethod) {
   auto* copiedReturnValue = copyObject(returnValue);
 
   auto* castedReturnValue = builder->CreateBitCast(copiedReturnValue, currFuncReturnType);
+  if (callProfileBuilder.isEnabled()) {
+    callProfileBuilder.genExit(activation);
+  }
   builder->CreateRet(castedReturnValue);
+  debugInfoBuilder.finalizeSubprogram(currLLVMFunction);
   llvm::verifyFunction(*currLLVMFunction, &(llvm::errs()));
 }
 
@@ -92,7 +130,10 @@ void CodeBuilder::visitFormalList(ast::FormalList* formalList) {
     builder->CreateStore(paramValue, paramValueAddress);
     assert(paramValue != nullptr);
 
-    currSymbolTable.add(paramName, paramValueAddress);
+    currSymbolTable.add(formal->getId()->getNameId(), paramValueAddress);
+    auto& paramTypeName = formal->getIdType()->getNameAsStr();
+    debugInfoBuilder.declareVariable(
+        paramValueAddress, paramName, paramTypeName, formal, paramCounter + 2);
     ++paramCounter;
   }
 }
@@ -109,23 +150,50 @@ void CodeBuilder::visitExpressions(ast::Expressions* exprs) {
 }
 
 void CodeBuilder::visitDispatch(ast::Dispatch* dispatch) {
+  ScopedDebugLocation location(debugInfoBuilder, dispatch);
   dispatch->getObjectId()->accept(this);
   auto* objectPtr = popStack();
-  assertNotNullptr(objectPtr);
+  genReceiverCheck(objectPtr, dispatch);
 
   auto* dispatchObjType = dispatch->getObjectId()->getSemantType();
   auto dispatchObjTypeName = dispatchObjType->getAsString();
   auto& methodsTable = env.globalMethodsTable[dispatchObjTypeName];
   auto& methodName = dispatch->getMethodId()->getNameAsStr();
-  auto data = methodsTable.lookup(methodName);
+  auto data = methodsTable.lookup(dispatch->getMethodId()->getNameId());
   assert(data.has_value());
 
-  auto* castedDispatchObj = builder->CreateBitCast(objectPtr, getPtrType(dispatchObjTypeName));
-  auto* dispatchTableAddress = builder->CreateGEP(castedDispatchObj, getGepIndices({0, 3}));
-  auto* dispatchTable = builder->CreateLoad(dispatchTableAddress);
+  auto siteName = getDispatchSiteName();
+  bool isIndirectCall{false};
+  llvm::Value* callee{nullptr};
+  if ((not exactSelfClassName.empty()) && isSelfReference(dispatch->getObjectId())) {
+    // the exact type of `self` is known inside a customized method
+    auto& exactMethodsTable = env.globalMethodsTable[exactSelfClassName];
+    auto exactData = exactMethodsTable.lookup(dispatch->getMethodId()->getNameId());
+    assert(exactData.has_value());
+    callee = module->getFunction(getImplementationName(exactSelfClassName, exactData.value()));
+    assert(callee != nullptr);
+    emitRemark<llvm::OptimizationRemark>("mcool-devirt",
+                                         "Devirtualized",
+                                         "dispatch of ",
+                                         llvm::ore::NV("Method", methodName),
+                                         " devirtualized to ",
+                                         llvm::ore::NV("Callee", callee),
+                                         " for the exact receiver class ",
+                                         llvm::ore::NV("Class", exactSelfClassName));
+  } else {
+    auto* castedDispatchObj = builder->CreateBitCast(objectPtr, getPtrType(dispatchObjTypeName));
+    auto* dispatchTableAddress = builder->CreateGEP(castedDispatchObj, getGepIndices({0, 3}));
+    auto* dispatchTable = builder->CreateLoad(dispatchTableAddress);
+
+    auto* calleeAddress =
+        builder->CreateGEP(dispatchTable, getGepIndices({0, data.value().offset}));
+    callee = builder->CreateLoad(calleeAddress);
+    isIndirectCall = true;
 
-  auto* calleeAddress = builder->CreateGEP(dispatchTable, getGepIndices({0, data.value().offset}));
-  auto* callee = builder->CreateLoad(calleeAddress);
+    if (not env.coolConfig.profileGenerateFile.empty()) {
+      genReceiverCounting(objectPtr, siteName);
+    }
+  }
 
   llvm::SmallVector<llvm::Value*> args{};
 
@@ -141,28 +209,44 @@ void CodeBuilder::visitDispatch(ast::Dispatch* dispatch) {
     args.push_back(popStack());
   }
 
+  auto& effects = env.dispatchEffects.at(dispatch);
+  if (isIndirectCall) {
+    uint64_t numOtherReceivers{0};
+    auto targets = getSpeculativeTargets(siteName, methodName, numOtherReceivers);
+    if (not targets.empty()) {
+      stack.push_back(genSpeculativeCall(callee, args, targets, numOtherReceivers, effects));
+      return;
+    }
+    emitRemark<llvm::OptimizationRemarkMissed>("mcool-devirt",
+                                               "IndirectDispatch",
+                                               "dispatch of ",
+                                               llvm::ore::NV("Method", methodName),
+                                               " through the dispatch table of ",
+                                               llvm::ore::NV("Class", dispatchObjTypeName));
+  }
+
   auto result = builder->CreateCall(calleeFunctionPtrType, callee, args);
+  addEffectAttributes(result, effects);
   stack.push_back(result);
 }
 
 void CodeBuilder::visitStaticDispatch(ast::StaticDispatch* dispatch) {
+  ScopedDebugLocation location(debugInfoBuilder, dispatch);
   dispatch->getObjectId()->accept(this);
   auto* objectPtr = popStack();
-  assertNotNullptr(objectPtr);
+  genReceiverCheck(objectPtr, dispatch);
 
-  auto* dispatchObjType = dispatch->getObjectId()->getSemantType();
-  auto dispatchObjTypeName = dispatchObjType->getAsString();
-  auto& methodsTable = env.globalMethodsTable[dispatchObjTypeName];
+  auto& staticCastTypeName = dispatch->getCastType()->getNameAsStr();
+  auto& methodsTable = env.globalMethodsTable[staticCastTypeName];
   auto& methodName = dispatch->getMethodId()->getNameAsStr();
-  auto data = methodsTable.lookup(methodName);
+  auto data = methodsTable.lookup(dispatch->getMethodId()->getNameId());
   assert(data.has_value());
 
-  auto& staticCastTypeName = dispatch->getCastType()->getNameAsStr();
-  auto dispatchTableName = getDispatchTableName(staticCastTypeName);
-  auto* dispatchTable = module->getGlobalVariable(dispatchTableName, true);
-
-  auto* calleeAddress = builder->CreateGEP(dispatchTable, getGepIndices({0, data.value().offset}));
-  auto* callee = builder->CreateLoad(calleeAddress);
+  // the receiver may belong to a subclass, hence the original method is called and not
+  // a clone, which would assume an exact type of `self`
+  auto& ownerName = data.value().owner->getCoolType()->getNameAsStr();
+  llvm::Value* callee = module->getFunction(getMethodName(ownerName, methodName));
+  assert(callee != nullptr);
 
   llvm::SmallVector<llvm::Value*> args{};
 
@@ -179,10 +263,12 @@ void CodeBuilder::visitStaticDispatch(ast::StaticDispatch* dispatch) {
   }
 
   auto result = builder->CreateCall(calleeFunctionPtrType, callee, args);
+  addEffectAttributes(result, env.dispatchEffects.at(dispatch));
   stack.push_back(result);
 }
 
 void CodeBuilder::visitWhileLoop(ast::WhileLoop* loop) {
+  ScopedDebugLocation location(debugInfoBuilder, loop);
   auto* loopHeaderBB = llvm::BasicBlock::Create(*context);
   auto* loopBodyBB = llvm::BasicBlock::Create(*context);
   auto* endLoopBB = llvm::BasicBlock::Create(*context);
@@ -199,8 +285,8 @@ void CodeBuilder::visitWhileLoop(ast::WhileLoop* loop) {
     auto* boolValue = builder->CreateLoad(boolAddress);
     auto* condValue = builder->CreateTrunc(boolValue, builder->getInt1Ty());
 
+    // the back edge must reach the whole predicate, which may span several blocks
     builder->CreateCondBr(condValue, loopBodyBB, endLoopBB);
-    loopHeaderBB = builder->GetInsertBlock();
   }
   {
     currLLVMFunction->getBasicBlockList().push_back(loopBodyBB);
@@ -224,6 +310,7 @@ void CodeBuilder::visitWhileLoop(ast::WhileLoop* loop) {
 }
 
 void CodeBuilder::visitIsVoidNode(ast::IsVoidNode* node) {
+  ScopedDebugLocation location(debugInfoBuilder, node);
   node->getTerm()->accept(this);
   auto* resultValue = popStack();
 
@@ -241,6 +328,7 @@ void CodeBuilder::visitIsVoidNode(ast::IsVoidNode* node) {
 }
 
 void CodeBuilder::visitNegationNode(ast::NegationNode* node) {
+  ScopedDebugLocation location(debugInfoBuilder, node);
   node->getTerm()->accept(this);
   auto* result = popStack();
   auto* address = builder->CreateGEP(result, getGepIndices({0, 4}));
@@ -254,6 +342,7 @@ void CodeBuilder::visitNegationNode(ast::NegationNode* node) {
 }
 
 void CodeBuilder::visitNotExpr(ast::NotExpr* noExpr) {
+  ScopedDebugLocation location(debugInfoBuilder, noExpr);
   noExpr->getExpr()->accept(this);
   auto* result = popStack();
   auto* address = builder->CreateGEP(result, getGepIndices({0, 4}));
@@ -267,6 +356,7 @@ void CodeBuilder::visitNotExpr(ast::NotExpr* noExpr) {
 }
 
 void CodeBuilder::visitNewExpr(ast::NewExpr* newExpr) {
+  ScopedDebugLocation location(debugInfoBuilder, newExpr);
   auto& newTypeName = newExpr->getNewType()->getNameAsStr();
   auto* newObject = createNewClassInstanceOnHeap(newTypeName);
 
@@ -278,9 +368,10 @@ void CodeBuilder::visitNewExpr(ast::NewExpr* newExpr) {
 }
 
 void CodeBuilder::visitCaseExpr(ast::CaseExpr* caseExpr) {
+  ScopedDebugLocation location(debugInfoBuilder, caseExpr);
   caseExpr->getExpr()->accept(this);
   auto* exprValue = popStack();
-  assertNotNullptr(exprValue);
+  genReceiverCheck(exprValue, caseExpr);
 
   auto* address = builder->CreateGEP(exprValue, getGepIndices({0, 1}));
   auto* exprClassTag = builder->CreateLoad(address);
@@ -330,7 +421,9 @@ void CodeBuilder::visitCaseExpr(ast::CaseExpr* caseExpr) {
     builder->CreateStore(castedCaseExprValue, bindVarAddress);
 
     currSymbolTable.pushScope();
-    currSymbolTable.add(aCase->getId()->getNameAsStr(), bindVarAddress);
+    currSymbolTable.add(aCase->getId()->getNameId(), bindVarAddress);
+    debugInfoBuilder.declareVariable(
+        bindVarAddress, aCase->getId()->getNameAsStr(), bindVarTypeName, aCase);
 
     aCase->getBody()->accept(this);
     auto* result = popStack();
@@ -360,9 +453,11 @@ void CodeBuilder::visitCaseList(ast::CaseList* caseList) {}
 void CodeBuilder::visitSingleCase(ast::SingleCase* aCase) {}
 
 void CodeBuilder::visitLetExpr(ast::LetExpr* letExpr) {
+  ScopedDebugLocation location(debugInfoBuilder, letExpr);
   auto& varTypeName = letExpr->getIdType()->getNameAsStr();
   auto* varTypePtr = getPtrType(varTypeName);
   llvm::Value* varPtr = genAlloca(varTypePtr);
+  debugInfoBuilder.declareVariable(varPtr, letExpr->getId()->getNameAsStr(), varTypeName, letExpr);
 
   letExpr->getInitExpr()->accept(this);
   if (auto* initExprValue = popStack()) {
@@ -373,13 +468,14 @@ void CodeBuilder::visitLetExpr(ast::LetExpr* letExpr) {
     builder->CreateStore(nullPtr, varPtr);
   }
   currSymbolTable.pushScope();
-  currSymbolTable.add(letExpr->getId()->getNameAsStr(), varPtr);
+  currSymbolTable.add(letExpr->getId()->getNameId(), varPtr);
 
   letExpr->getBody()->accept(this);
   currSymbolTable.popScope();
 }
 
 void CodeBuilder::visitIfThenExpr(ast::IfThenExpr* condExpr) {
+  ScopedDebugLocation location(debugInfoBuilder, condExpr);
   condExpr->getCondition()->accept(this);
   auto* condResult = popStack();
 
@@ -432,6 +528,7 @@ void CodeBuilder::visitIfThenExpr(ast::IfThenExpr* condExpr) {
 }
 
 void CodeBuilder::visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) {
+  ScopedDebugLocation location(debugInfoBuilder, condExpr);
   condExpr->getCondition()->accept(this);
   auto* condResult = popStack();
 
@@ -486,6 +583,7 @@ void CodeBuilder::visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) {
 void CodeBuilder::visitNoExpr(ast::NoExpr*) { stack.push_back(nullptr); }
 
 void CodeBuilder::visitEqualNode(ast::EqualNode* node) {
+  ScopedDebugLocation location(debugInfoBuilder, node);
   auto* semantType = node->getLeft()->getSemantType();
   auto semantTypeName = semantType->getAsString();
 
@@ -566,6 +664,7 @@ void CodeBuilder::visitLessEqualNode(ast::LessEqualNode* node) {
 }
 
 void CodeBuilder::visitBinaryNode(ast::BinaryExpression* node, IntegralBinaryOp op) {
+  ScopedDebugLocation location(debugInfoBuilder, node);
   node->getRight()->accept(this);
   auto* rightIntObj = popStack();
   auto* rightValueAddress = builder->CreateGEP(rightIntObj, getGepIndices({0, 4}));
@@ -597,14 +696,17 @@ void CodeBuilder::visitBinaryNode(ast::BinaryExpression* node, IntegralBinaryOp
   case IntegralBinaryOp::Eq: {
     auto* boolValue = builder->CreateICmpEQ(leftValue, rightValue);
     resultValue = builder->CreateZExt(boolValue, builder->getInt32Ty());
+    break;
   }
   case IntegralBinaryOp::Less: {
     auto* boolValue = builder->CreateICmpSLT(leftValue, rightValue);
     resultValue = builder->CreateZExt(boolValue, builder->getInt32Ty());
+    break;
   }
   case IntegralBinaryOp::Leq: {
     auto* boolValue = builder->CreateICmpSLE(leftValue, rightValue);
     resultValue = builder->CreateZExt(boolValue, builder->getInt32Ty());
+    break;
   }
   }
   auto resultTypeName = node->getSemantType()->getAsString();
@@ -616,6 +718,7 @@ void CodeBuilder::visitBinaryNode(ast::BinaryExpression* node, IntegralBinaryOp
 }
 
 void CodeBuilder::visitAssignExpr(ast::AssignExpr* node) {
+  ScopedDebugLocation location(debugInfoBuilder, node);
   getLObjValue(node->getId());
   auto* idAddress = popStack();
 
@@ -637,6 +740,7 @@ void CodeBuilder::visitAssignExpr(ast::AssignExpr* node) {
 void CodeBuilder::visitPrimaryExpr(ast::PrimaryExpr* node) { node->getTerm()->accept(this); }
 
 void CodeBuilder::visitObjectId(ast::ObjectId* id) {
+  ScopedDebugLocation location(debugInfoBuilder, id);
   getLObjValue(id);
   auto* address = popStack();
   assert(address != nullptr);
@@ -644,15 +748,15 @@ void CodeBuilder::visitObjectId(ast::ObjectId* id) {
 }
 
 void CodeBuilder::getLObjValue(ast::ObjectId* id) {
-  auto& idName = id->getNameAsStr();
-  if (auto currScopeResults = currSymbolTable.lookup(idName)) {
+  auto symbol = id->getNameId();
+  if (auto currScopeResults = currSymbolTable.lookup(symbol)) {
     stack.push_back(currScopeResults.value());
   } else {
-    auto* selfPtrAddress = currSymbolTable.lookup("self").value();
+    auto* selfPtrAddress = currSymbolTable.lookup(selfId).value();
     auto* selfPtr = builder->CreateLoad(selfPtrAddress);
 
     auto& membersTable = env.globalMembersTable[currClassName];
-    if (auto classScopeResult = membersTable.lookup(idName)) {
+    if (auto classScopeResult = membersTable.lookup(symbol)) {
       auto [_, offset] = classScopeResult.value();
       auto* address = builder->CreateGEP(selfPtr, getGepIndices({0, offset}));
       stack.push_back(address);
@@ -663,6 +767,7 @@ void CodeBuilder::getLObjValue(ast::ObjectId* id) {
 }
 
 void CodeBuilder::visitBool(ast::Bool* item) {
+  ScopedDebugLocation location(debugInfoBuilder, item);
   auto* boolPtr = createNewClassInstanceOnStack("Bool");
   auto* valueAddress = builder->CreateGEP(boolPtr, getGepIndices({0, 4}));
   auto* literalConstant = builder->getInt32(item->getValue());
@@ -671,6 +776,7 @@ void CodeBuilder::visitBool(ast::Bool* item) {
 }
 
 void CodeBuilder::visitInt(ast::Int* item) {
+  ScopedDebugLocation location(debugInfoBuilder, item);
   auto* intPtr = createNewClassInstanceOnStack("Int");
   auto* valueAddress = builder->CreateGEP(intPtr, getGepIndices({0, 4}));
   auto* literalConstant = builder->getInt32(item->getValue());
@@ -679,6 +785,7 @@ void CodeBuilder::visitInt(ast::Int* item) {
 }
 
 void CodeBuilder::visitString(ast::String* str) {
+  ScopedDebugLocation location(debugInfoBuilder, str);
   llvm::Value* intPtr{nullptr};
   {
     intPtr = createNewClassInstanceOnHeap("Int");
@@ -1,13 +1,31 @@
 #include "CodeGen/CodeGenDriver.h"
 #include "CodeGen/Initializer.h"
+#include "CodeGen/ReachabilityAnalysis.h"
+#include "CodeGen/MethodCustomizer.h"
 #include "CodeGen/BuiltinMethodsBuilder.h"
 #include "CodeGen/CodeBuilder.h"
+#include "CodeGen/NullnessAnalysis.h"
+#include "CodeGen/EffectAnalysis.h"
+#include "CodeGen/AliasMetadataBuilder.h"
+#include "CodeGen/ReceiverProfileBuilder.h"
+#include "CodeGen/DebugInfoBuilder.h"
+#include "CodeGen/CallProfileBuilder.h"
+#include "CodeGen/HeapProfileBuilder.h"
+#include "PhaseTimer.h"
 #include "llvm/Target/TargetOptions.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/Host.h"
 #include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/LLVMRemarkStreamer.h"
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/PassTimingInfo.h"
+#include "llvm/Pass.h"
+#include "llvm/Passes/StandardInstrumentations.h"
+#include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/FileSystem.h"
+#include <array>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 
@@ -18,16 +36,108 @@ bool CodeGenDriver::run(mcool::AstTree& classes) {
     return false;
   }
 
+  ReachabilityAnalysis reachabilityAnalysis(env);
+  {
+    misc::ScopedPhase phase("Reachability analysis");
+    reachabilityAnalysis.run(classes);
+  }
+
+  if (env.coolConfig.customizationBudget > 0) {
+    misc::ScopedPhase phase("Method customization");
+    MethodCustomizer methodCustomizer(env);
+    methodCustomizer.run(classes);
+  }
+
   Initializer initializer(env, classes);
-  initializer.run();
+  {
+    misc::ScopedPhase phase("Initializer");
+    initializer.run();
+  }
+
+  HeapProfileBuilder heapProfileBuilder(env);
+  if (heapProfileBuilder.isEnabled()) {
+    heapProfileBuilder.init();
+  }
 
   BuiltinMethodsBuilder builtinMethodsBuilder(env);
-  builtinMethodsBuilder.build();
+  {
+    misc::ScopedPhase phase("Builtin methods");
+    builtinMethodsBuilder.build();
+  }
+
+  NullnessAnalysis nullnessAnalysis(env);
+  {
+    misc::ScopedPhase phase("Nullness analysis");
+    nullnessAnalysis.run(classes);
+  }
+
+  EffectAnalysis effectAnalysis(env);
+  {
+    misc::ScopedPhase phase("Effect analysis");
+    effectAnalysis.run(classes);
+  }
+
+  // with an llvm ir profile, llvm promotes hot dispatches using value profiles of indirect
+  // calls; speculating them here would change the control flow the ir profile was taken for
+  auto& profileUseFile = env.coolConfig.profileUseFile;
+  hasIRProfile = (not profileUseFile.empty()) &&
+                 std::filesystem::exists(getIndexedIRProfileName(profileUseFile));
+  ReceiverProfileBuilder receiverProfileBuilder(env);
+  if ((not profileUseFile.empty()) && (not hasIRProfile)) {
+    isOk = receiverProfileBuilder.readProfile();
+    if (not isOk) {
+      return false;
+    }
+  }
 
-  CodeBuilder codeBuilder(env);
-  codeBuilder.genConstructors(classes);
-  codeBuilder.genMethods(classes);
-  codeBuilder.generatedMainEntryPoint();
+  isOk = initOptRemarks();
+  if (not isOk) {
+    return false;
+  }
+
+  DebugInfoBuilder debugInfoBuilder(env);
+  debugInfoBuilder.init();
+
+  {
+    misc::ScopedPhase phase("Code builder");
+    CodeBuilder codeBuilder(env);
+    codeBuilder.genConstructors(classes);
+    codeBuilder.genMethods(classes);
+    if (not env.coolConfig.profileGenerateFile.empty()) {
+      receiverProfileBuilder.genProfileWriter();
+    }
+    CallProfileBuilder callProfileBuilder(env);
+    if (callProfileBuilder.isEnabled()) {
+      callProfileBuilder.genProfileWriter();
+    }
+    if (heapProfileBuilder.isEnabled()) {
+      heapProfileBuilder.genProfileWriter();
+    }
+    codeBuilder.generatedMainEntryPoint();
+    debugInfoBuilder.finalize();
+  }
+
+  AliasMetadataBuilder aliasMetadataBuilder(env, classes);
+  {
+    misc::ScopedPhase phase("Alias metadata");
+    aliasMetadataBuilder.build();
+  }
+
+  bool hasPGO = (not env.coolConfig.profileGenerateFile.empty()) || hasIRProfile;
+  if ((env.coolConfig.optLevel > 0) || hasPGO) {
+    misc::ScopedPhase phase("LLVM optimization");
+    optimizeModule();
+  }
+
+  if (optRemarksFile != nullptr) {
+    optRemarksFile->keep();
+  }
+  // line tables requested only to locate remarks and allocation sites must not end up
+  // in the output
+  bool hasDebugInfoOption = env.coolConfig.emitDebugInfo || env.coolConfig.lineTablesOnly;
+  if (not hasDebugInfoOption) {
+    llvm::StripDebugInfo(*env.llvmModule);
+  }
 
   if (env.coolConfig.emitLLVMIr) {
     isOk = writeLLVMIr();
@@ -41,6 +151,7 @@ bool CodeGenDriver::run(mcool::AstTree& classes) {
     fileType = llvm::CGFT_AssemblyFile;
   }
 
+  misc::ScopedPhase phase("LLVM emission");
   isOk = writeOutputFile(fileType);
   return isOk;
 }
@@ -73,6 +184,90 @@ bool CodeGenDriver::initDataLayout() {
   return true;
 }
 
+// remarks of llvm passes and the code builders are streamed to the same file
+bool CodeGenDriver::initOptRemarks() {
+  auto& remarksFile = env.coolConfig.optRemarksFile;
+  if (remarksFile.empty()) {
+    return true;
+  }
+
+  auto remarksOutput = llvm::setupLLVMOptimizationRemarks(
+      *env.llvmContext, remarksFile, "", "yaml", hasIRProfile);
+  if (auto error = remarksOutput.takeError()) {
+    std::cerr << "codegen error: cannot open remarks file: `" << remarksFile
+              << "`: " << llvm::toString(std::move(error)) << '\n';
+    return false;
+  }
+  optRemarksFile = std::move(*remarksOutput);
+  return true;
+}
+
+void CodeGenDriver::optimizeModule() {
+  llvm::LoopAnalysisManager loopAnalysisManager;
+  llvm::FunctionAnalysisManager functionAnalysisManager;
+  llvm::CGSCCAnalysisManager cgsccAnalysisManager;
+  llvm::ModuleAnalysisManager moduleAnalysisManager;
+
+  // llvm passes add their own events to the trace, see `PhaseTimer`
+  llvm::PassInstrumentationCallbacks instrumentationCallbacks;
+  llvm::TimePassesHandler timePassesHandler(env.coolConfig.timePhases);
+  timePassesHandler.registerCallbacks(instrumentationCallbacks);
+
+  llvm::PassBuilder passBuilder(false,
+                                targetMachine,
+                                llvm::PipelineTuningOptions(),
+                                getPGOOptions(),
+                                &instrumentationCallbacks);
+  passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+  passBuilder.registerCGSCCAnalyses(cgsccAnalysisManager);
+  passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+  passBuilder.registerLoopAnalyses(loopAnalysisManager);
+  passBuilder.crossRegisterProxies(
+      loopAnalysisManager, functionAnalysisManager, cgsccAnalysisManager, moduleAnalysisManager);
+
+  using OptimizationLevel = llvm::PassBuilder::OptimizationLevel;
+  const std::array<OptimizationLevel, 4> levels{
+      OptimizationLevel::O0, OptimizationLevel::O1, OptimizationLevel::O2, OptimizationLevel::O3};
+  auto level = levels.at(env.coolConfig.optLevel);
+
+  // the default pipeline asserts on -O0, thus only the passes which instrument or use an
+  // llvm ir profile run there, the same way as in clang
+  if (level == OptimizationLevel::O0) {
+    auto pgoOptions = getPGOOptions();
+    if (not pgoOptions.hasValue()) {
+      return;
+    }
+    llvm::ModulePassManager modulePassManager(false);
+    bool isProfileGeneration = pgoOptions->Action == llvm::PGOOptions::IRInstr;
+    passBuilder.addPGOInstrPassesForO0(modulePassManager,
+                                       false,
+                                       isProfileGeneration,
+                                       false,
+                                       pgoOptions->ProfileFile,
+                                       pgoOptions->ProfileRemappingFile);
+    modulePassManager.run(*env.llvmModule, moduleAnalysisManager);
+    return;
+  }
+
+  auto modulePassManager = passBuilder.buildPerModuleDefaultPipeline(level);
+  modulePassManager.run(*env.llvmModule, moduleAnalysisManager);
+}
+
+// llvm ir profiles are kept next to the receiver-type profile, see `README.md`
+llvm::Optional<llvm::PGOOptions> CodeGenDriver::getPGOOptions() {
+  auto& profileGenerateFile = env.coolConfig.profileGenerateFile;
+  if (not profileGenerateFile.empty()) {
+    return llvm::PGOOptions(
+        getRawIRProfileName(profileGenerateFile), "", "", llvm::PGOOptions::IRInstr);
+  }
+
+  if (hasIRProfile) {
+    auto indexedProfileFile = getIndexedIRProfileName(env.coolConfig.profileUseFile);
+    return llvm::PGOOptions(indexedProfileFile, "", "", llvm::PGOOptions::IRUse);
+  }
+  return llvm::None;
+}
+
 bool CodeGenDriver::writeOutputFile(llvm::CodeGenFileType fileType) {
   const std::string fileSuffix = (fileType == llvm::CGFT_AssemblyFile) ? ".s" : ".o";
   auto outputFile = env.coolConfig.outputFile + fileSuffix;
@@ -84,6 +279,7 @@ bool CodeGenDriver::writeOutputFile(llvm::CodeGenFileType fileType) {
     return false;
   }
 
+  llvm::TimePassesIsEnabled = env.coolConfig.timePhases;
   llvm::legacy::PassManager pass;
   if (targetMachine->addPassesToEmitFile(pass, dest, nullptr, fileType)) {
     llvm::errs() << "TargetMachine can't emit a file of this type" << '\n';
@@ -92,9 +288,41 @@ bool CodeGenDriver::writeOutputFile(llvm::CodeGenFileType fileType) {
 
   pass.run(*env.llvmModule);
   dest.flush();
+  if (env.coolConfig.timePhases) {
+    llvm::reportAndResetTimings();
+  }
   return true;
 }
 
+// counts the module as it was written to the output file, i.e. after optimization
+void CodeGenDriver::collectStatistics(misc::Statistics& statistics) {
+  uint64_t numDefinitions{0};
+  uint64_t numDeclarations{0};
+  uint64_t numBasicBlocks{0};
+  uint64_t numInstructions{0};
+  for (auto& function : *env.llvmModule) {
+    if (function.isDeclaration()) {
+      ++numDeclarations;
+      continue;
+    }
+    ++numDefinitions;
+    numBasicBlocks += function.size();
+    numInstructions += function.getInstructionCount();
+  }
+  statistics.add("llvm module", "functions", numDefinitions);
+  statistics.add("llvm module", "declarations", numDeclarations);
+  statistics.add("llvm module", "globals", env.llvmModule->global_size());
+  statistics.add("llvm module", "basic blocks", numBasicBlocks);
+  statistics.add("llvm module", "instructions", numInstructions);
+
+  const std::string fileSuffix = env.coolConfig.writeAsmOutput ? ".s" : ".o";
+  std::error_code errorCode;
+  auto fileSize = std::filesystem::file_size(env.coolConfig.outputFile + fileSuffix, errorCode);
+  if (not errorCode) {
+    statistics.add("output", fileSuffix == ".s" ? "assembly bytes" : "object bytes", fileSize);
+  }
+}
+
 bool CodeGenDriver::writeLLVMIr() {
   auto outputFile = env.coolConfig.outputFile + ".ll";
   std::error_code error{};
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "CodeGen/Environment.h"
+#include "Statistics.h"
 #include "llvm/Target/TargetMachine.h"
+#include "llvm/Support/PGOOptions.h"
+#include "llvm/Support/ToolOutputFile.h"
 #include <ostream>
 
 
@@ -12,9 +15,13 @@ class CodeGenDriver {
       : env(context, coolConfig) {
   }
   bool run(mcool::AstTree& classes);
+  void collectStatistics(misc::Statistics& statistics);
 
   private:
   bool initDataLayout();
+  bool initOptRemarks();
+  void optimizeModule();
+  llvm::Optional<llvm::PGOOptions> getPGOOptions();
   bool writeOutputFile(llvm::CodeGenFileType fileType);
   bool writeLLVMIr();
   bool readLLVMIr();
@@ -22,5 +29,7 @@ class CodeGenDriver {
   Environment env;
   llvm::TargetMachine* targetMachine{};
   std::string targetTriple{};
+  bool hasIRProfile{false};
+  std::unique_ptr<llvm::ToolOutputFile> optRemarksFile{};
 };
 } // namespace mcool::codegen
\ No newline at end of file
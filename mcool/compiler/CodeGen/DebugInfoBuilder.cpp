@@ -0,0 +1,230 @@
+#include "CodeGen/DebugInfoBuilder.h"
+#include "llvm/BinaryFormat/Dwarf.h"
+#include <filesystem>
+
+namespace mcool::codegen {
+void DebugInfoBuilder::init() {
+  auto& config = env.coolConfig;
+  // optimization remarks and allocation sites are located by line tables
+  bool needsLineTables = config.lineTablesOnly || (not config.optRemarksFile.empty()) ||
+                         (not config.heapProfileFile.empty());
+  if (not(config.emitDebugInfo || needsLineTables)) {
+    return;
+  }
+
+  env.llvmDIBuilder = std::make_unique<llvm::DIBuilder>(*module);
+  // `--line-tables-only` takes precedence over `-g`
+  bool isFullDebugInfo = config.emitDebugInfo && (not config.lineTablesOnly);
+  auto emissionKind = isFullDebugInfo ? llvm::DICompileUnit::FullDebug
+                                      : llvm::DICompileUnit::LineTablesOnly;
+
+  // COOL has no DWARF language code of its own
+  auto* file = getFile(nullptr);
+  env.diCompileUnit = env.llvmDIBuilder->createCompileUnit(
+      llvm::dwarf::DW_LANG_C, file, "mcool", config.optLevel > 0, "", 0, "", emissionKind);
+
+  module->addModuleFlag(
+      llvm::Module::Warning, "Debug Info Version", llvm::DEBUG_METADATA_VERSION);
+  module->addModuleFlag(llvm::Module::Warning, "Dwarf Version", 4);
+}
+
+void DebugInfoBuilder::finalize() {
+  if (isEnabled()) {
+    env.llvmDIBuilder->finalize();
+  }
+}
+
+void DebugInfoBuilder::genSubprogram(llvm::Function* function, ast::Node* node) {
+  if (not isEnabled()) {
+    return;
+  }
+  auto& diBuilder = env.llvmDIBuilder;
+
+  llvm::SmallVector<llvm::Metadata*> signature{};
+  if (isFullDebugInfo()) {
+    auto* returnType = function->getReturnType();
+    if (returnType->isPointerTy()) {
+      auto* classType = llvm::cast<llvm::PointerType>(returnType)->getElementType();
+      signature.push_back(getClassPtrType(classType->getStructName().str()));
+    } else {
+      signature.push_back(diBuilder->createBasicType("int", 32, llvm::dwarf::DW_ATE_signed));
+    }
+
+    for (auto& arg : function->args()) {
+      auto* classType = llvm::cast<llvm::PointerType>(arg.getType())->getElementType();
+      signature.push_back(getClassPtrType(classType->getStructName().str()));
+    }
+  }
+  auto* subroutineType =
+      diBuilder->createSubroutineType(diBuilder->getOrCreateTypeArray(signature));
+
+  auto spFlags = llvm::DISubprogram::SPFlagDefinition;
+  if (function->hasLocalLinkage()) {
+    spFlags |= llvm::DISubprogram::SPFlagLocalToUnit;
+  }
+  if (env.coolConfig.optLevel > 0) {
+    spFlags |= llvm::DISubprogram::SPFlagOptimized;
+  }
+
+  auto* file = getFile(node);
+  unsigned line = (node != nullptr) ? node->getLocation().begin.line : 0;
+  auto* subprogram = diBuilder->createFunction(file,
+                                               function->getName(),
+                                               "",
+                                               file,
+                                               line,
+                                               subroutineType,
+                                               line,
+                                               llvm::DINode::FlagPrototyped,
+                                               spFlags);
+  function->setSubprogram(subprogram);
+  builder->SetCurrentDebugLocation(llvm::DILocation::get(*context, line, 0, subprogram));
+}
+
+// resolves local variables of a subprogram, so that its function can be verified
+void DebugInfoBuilder::finalizeSubprogram(llvm::Function* function) {
+  if (auto* subprogram = function->getSubprogram()) {
+    env.llvmDIBuilder->finalizeSubprogram(subprogram);
+  }
+  restoreLocation(llvm::DebugLoc());
+}
+
+llvm::DebugLoc DebugInfoBuilder::setLocation(ast::Node* node) {
+  auto previousLocation = builder->getCurrentDebugLocation();
+  if (not isEnabled()) {
+    return previousLocation;
+  }
+
+  auto* subprogram = builder->GetInsertBlock()->getParent()->getSubprogram();
+  auto& location = node->getLocation();
+  if ((subprogram == nullptr) || (location.begin.line == 0)) {
+    return previousLocation;
+  }
+
+  auto line = location.begin.line;
+  auto column = location.begin.column;
+  builder->SetCurrentDebugLocation(llvm::DILocation::get(*context, line, column, subprogram));
+  return previousLocation;
+}
+
+void DebugInfoBuilder::declareVariable(llvm::Value* address,
+                                       const std::string& name,
+                                       const std::string& className,
+                                       ast::Node* node,
+                                       unsigned argNumber) {
+  if ((not isEnabled()) || (not isFullDebugInfo())) {
+    return;
+  }
+  auto& diBuilder = env.llvmDIBuilder;
+
+  auto* subprogram = builder->GetInsertBlock()->getParent()->getSubprogram();
+  assert(subprogram != nullptr);
+
+  auto* file = getFile(node);
+  auto& location = node->getLocation();
+  unsigned line = location.begin.line;
+  auto* type = getClassPtrType(className);
+
+  llvm::DILocalVariable* variable{nullptr};
+  if (argNumber > 0) {
+    variable = diBuilder->createParameterVariable(subprogram, name, argNumber, file, line, type);
+  } else {
+    variable = diBuilder->createAutoVariable(subprogram, name, file, line, type);
+  }
+
+  auto* diLocation = llvm::DILocation::get(*context, line, location.begin.column, subprogram);
+  diBuilder->insertDeclare(
+      address, variable, diBuilder->createExpression(), diLocation, builder->GetInsertBlock());
+}
+
+// nodes without a location, e.g. of builtin classes, belong to the first input file
+llvm::DIFile* DebugInfoBuilder::getFile(ast::Node* node) {
+  std::string fileName{};
+  if ((node != nullptr) && (node->getLocation().filename != nullptr)) {
+    fileName = node->getLocation().filename->get();
+  } else {
+    fileName = env.coolConfig.inputFiles.front();
+  }
+
+  auto it = env.diFiles.find(fileName);
+  if (it == env.diFiles.end()) {
+    auto path = std::filesystem::absolute(fileName);
+    auto* file = env.llvmDIBuilder->createFile(path.filename().string(),
+                                               path.parent_path().string());
+    it = env.diFiles.insert({fileName, file}).first;
+  }
+  return it->second;
+}
+
+llvm::DIType* DebugInfoBuilder::getClassPtrType(const std::string& className) {
+  auto pointerSize = module->getDataLayout().getPointerSizeInBits();
+  return env.llvmDIBuilder->createPointerType(getClassType(className), pointerSize);
+}
+
+// classes are described with their own fields; the object header is left out
+llvm::DIType* DebugInfoBuilder::getClassType(const std::string& className) {
+  auto it = env.diClassTypes.find(className);
+  if (it != env.diClassTypes.end()) {
+    return it->second;
+  }
+
+  auto* structType = llvm::StructType::getTypeByName(*context, className);
+  if (structType == nullptr) {
+    return getClassType("Object");
+  }
+
+  auto& diBuilder = env.llvmDIBuilder;
+  auto& dataLayout = module->getDataLayout();
+  auto* structLayout = dataLayout.getStructLayout(structType);
+  auto* file = env.diCompileUnit->getFile();
+  auto* classType = diBuilder->createStructType(env.diCompileUnit,
+                                                className,
+                                                file,
+                                                0,
+                                                structLayout->getSizeInBits(),
+                                                dataLayout.getABITypeAlignment(structType) * 8,
+                                                llvm::DINode::FlagZero,
+                                                nullptr,
+                                                diBuilder->getOrCreateArray({}));
+  env.diClassTypes.insert({className, classType});
+
+  auto createField = [&](const std::string& name, unsigned index, llvm::DIType* type) {
+    auto* fieldType = structType->getElementType(index);
+    return diBuilder->createMemberType(classType,
+                                       name,
+                                       file,
+                                       0,
+                                       dataLayout.getTypeSizeInBits(fieldType),
+                                       dataLayout.getABITypeAlignment(fieldType) * 8,
+                                       structLayout->getElementOffsetInBits(index),
+                                       llvm::DINode::FlagZero,
+                                       type);
+  };
+
+  llvm::SmallVector<llvm::Metadata*> fields{};
+  if (className == "Int") {
+    auto* valueType = diBuilder->createBasicType("int", 32, llvm::dwarf::DW_ATE_signed);
+    fields.push_back(createField("value", 4, valueType));
+  } else if (className == "Bool") {
+    auto* valueType = diBuilder->createBasicType("bool", 32, llvm::dwarf::DW_ATE_boolean);
+    fields.push_back(createField("value", 4, valueType));
+  } else if (className == "String") {
+    auto* charType = diBuilder->createBasicType("char", 8, llvm::dwarf::DW_ATE_signed_char);
+    auto* strType = diBuilder->createPointerType(charType, dataLayout.getPointerSizeInBits());
+    fields.push_back(createField("length", 4, getClassPtrType("Int")));
+    fields.push_back(createField("str", 5, strType));
+  } else {
+    for (auto scope : env.globalMembersTable[className].getScopes()) {
+      for (auto& item : scope) {
+        auto* id = item.value.member->getId();
+        auto* type = getClassPtrType(id->getSemantType()->getAsString());
+        fields.push_back(createField(id->getNameAsStr(), item.value.offset, type));
+      }
+    }
+  }
+
+  diBuilder->replaceArrays(classType, diBuilder->getOrCreateArray(fields));
+  env.diClassTypes[className] = classType;
+  return classType;
+}
+} // namespace mcool::codegen
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CodeGen/BaseBuilder.h"
+#include "llvm/IR/DIBuilder.h"
+
+namespace mcool::codegen {
+// Builds DWARF metadata from source locations of AST nodes. In the line-tables-only mode only
+// subprograms and locations are emitted; full debug info additionally describes classes and
+// local variables. Debug info is never a reason to emit different instructions.
+class DebugInfoBuilder : public BaseBuilder {
+  public:
+  explicit DebugInfoBuilder(Environment& env) : BaseBuilder(env) {}
+
+  bool isEnabled() { return env.llvmDIBuilder != nullptr; }
+  void init();
+  void finalize();
+
+  void genSubprogram(llvm::Function* function, ast::Node* node);
+  void finalizeSubprogram(llvm::Function* function);
+  // returns the location which was set before
+  llvm::DebugLoc setLocation(ast::Node* node);
+  void restoreLocation(llvm::DebugLoc location) { builder->SetCurrentDebugLocation(location); }
+  void declareVariable(llvm::Value* address,
+                       const std::string& name,
+                       const std::string& className,
+                       ast::Node* node,
+                       unsigned argNumber = 0);
+
+  private:
+  llvm::DIFile* getFile(ast::Node* node);
+  llvm::DIType* getClassPtrType(const std::string& className);
+  llvm::DIType* getClassType(const std::string& className);
+  bool isFullDebugInfo() {
+    return env.diCompileUnit->getEmissionKind() == llvm::DICompileUnit::FullDebug;
+  }
+};
+
+// sets the location of a node for the instructions emitted within a scope and restores the
+// previous location at its end, i.e. after the children of the node have been visited
+class ScopedDebugLocation {
+  public:
+  ScopedDebugLocation(DebugInfoBuilder& debugInfoBuilder, ast::Node* node)
+      : debugInfoBuilder(debugInfoBuilder), previousLocation(debugInfoBuilder.setLocation(node)) {}
+  ~ScopedDebugLocation() { debugInfoBuilder.restoreLocation(previousLocation); }
+
+  private:
+  DebugInfoBuilder& debugInfoBuilder;
+  llvm::DebugLoc previousLocation;
+};
+} // namespace mcool::codegen
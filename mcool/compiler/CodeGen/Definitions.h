@@ -1,9 +1,12 @@
 #pragma once
 
 #include "llvm/IR/Value.h"
+#include "llvm/IR/GlobalVariable.h"
 
 #include "ast.h"
 #include "SymbolTable.h"
+#include <cstdint>
+#include <map>
 #include <unordered_map>
 
 namespace mcool::codegen {
@@ -16,14 +19,41 @@ struct MethodsTableData {
   ast::CoolClass* owner{};
   ast::SingleMethod* method{};
   int offset{};
+  bool isCustomized{false};
 };
 
-using MembersTable = mcool::type::SymbolTable<std::string, MembersTableData>;
+struct CustomizedMethod {
+  ast::CoolClass* owner{};
+  ast::SingleMethod* method{};
+};
+
+struct MethodEffects {
+  bool readsMemory{false};
+  bool writesMemory{false};
+  bool mayNotReturn{false};
+  bool returnsNewObject{true};
+  bool hasImmutableResult{false};
+};
+
+using MembersTable = mcool::type::SymbolTable<MembersTableData>;
 using GlobalMembersTable = std::unordered_map<std::string, MembersTable>;
 
-using MethodsTable = mcool::type::SymbolTable<std::string, MethodsTableData>;
+using MethodsTable = mcool::type::SymbolTable<MethodsTableData>;
 using GlobalMethodsTable = std::unordered_map<std::string, MethodsTable>;
 
-using SymbolTable = mcool::type::SymbolTable<std::string, llvm::Value*>;
+// customized methods of a class by their names
+using CustomizedMethods = std::map<std::string, CustomizedMethod>;
+
+// numbers of receivers of every class met at a dispatch site
+using ReceiverHistogram = std::map<std::string, uint64_t>;
+// receiver histograms of dispatch sites by site names
+using ReceiverProfile = std::unordered_map<std::string, ReceiverHistogram>;
+
+struct InstrumentedDispatchSite {
+  std::string name{};
+  llvm::GlobalVariable* counters{};
+};
+
+using SymbolTable = mcool::type::SymbolTable<llvm::Value*>;
 using GlobalSymbolTable = std::unordered_map<std::string, SymbolTable>;
 } // namespace mcool::codegen
\ No newline at end of file
@@ -0,0 +1,367 @@
+#include "CodeGen/EffectAnalysis.h"
+#include "CodeGen/Misc.h"
+#include "llvm/Support/Casting.h"
+#include <cassert>
+#include <set>
+
+namespace mcool::codegen {
+namespace {
+bool merge(MethodEffects& dst, const MethodEffects& src) {
+  auto before = dst;
+  dst.readsMemory = dst.readsMemory || src.readsMemory;
+  dst.writesMemory = dst.writesMemory || src.writesMemory;
+  dst.mayNotReturn = dst.mayNotReturn || src.mayNotReturn;
+  return (before.readsMemory != dst.readsMemory) || (before.writesMemory != dst.writesMemory) ||
+         (before.mayNotReturn != dst.mayNotReturn);
+}
+
+bool isImmutableType(const std::string& typeName) {
+  return (typeName == "Int") || (typeName == "Bool") || (typeName == "String");
+}
+} // namespace
+
+void EffectAnalysis::run(mcool::AstTree& classes) {
+  initBuiltinSummaries();
+  for (auto* coolClass : classes.get()->getData()) {
+    coolClass->accept(this);
+  }
+
+  markRecursiveFunctions();
+  propagateEffects();
+
+  for (auto& [name, summary] : summaries) {
+    env.methodEffects.insert({name, summary.effects});
+  }
+
+  for (auto& site : dispatchSites) {
+    MethodEffects effects{false, false, false, true, true};
+    for (auto& candidate : site.candidates) {
+      auto& candidateEffects = env.methodEffects.at(candidate);
+      merge(effects, candidateEffects);
+      effects.returnsNewObject = effects.returnsNewObject && candidateEffects.returnsNewObject;
+      effects.hasImmutableResult =
+          effects.hasImmutableResult && candidateEffects.hasImmutableResult;
+    }
+    if (site.candidates.empty()) {
+      effects = MethodEffects{true, true, true, false, false};
+    }
+
+    // a dispatch inside a customized method is visited once per clone
+    auto [it, isInserted] = env.dispatchEffects.insert({site.node, effects});
+    if (not isInserted) {
+      merge(it->second, effects);
+      it->second.returnsNewObject = it->second.returnsNewObject && effects.returnsNewObject;
+      it->second.hasImmutableResult = it->second.hasImmutableResult && effects.hasImmutableResult;
+    }
+  }
+
+  attachFunctionAttributes();
+}
+
+void EffectAnalysis::initBuiltinSummaries() {
+  // {reads, writes, mayNotReturn, returnsNewObject, hasImmutableResult}
+  const static std::unordered_map<std::string, MethodEffects> builtinEffects{
+      {"Object_copy", {true, false, false, true, false}},
+      {"Object_abort", {true, true, true, false, false}},
+      {"Object_type_name", {true, false, false, true, true}},
+      {"IO_out_string", {true, true, true, false, false}},
+      {"IO_out_int", {true, true, true, false, false}},
+      {"IO_in_string", {true, true, true, true, true}},
+      {"IO_in_int", {true, true, true, true, true}},
+      {"String_length", {true, false, false, true, true}},
+      {"String_concat", {true, false, false, true, true}},
+      {"String_substr", {true, false, false, true, true}},
+  };
+
+  for (auto& [name, effects] : builtinEffects) {
+    summaries[name].effects = effects;
+    // allocations update the counters of the heap profile, see `HeapProfileBuilder`
+    if (not env.coolConfig.heapProfileFile.empty()) {
+      summaries[name].effects.writesMemory = true;
+    }
+  }
+}
+
+void EffectAnalysis::visitCoolClass(ast::CoolClass* coolClass) {
+  const static std::unordered_set<std::string> defaultClasses{
+      "Object", "IO", "Int", "String", "Bool"};
+  currClassName = coolClass->getCoolType()->getNameAsStr();
+
+  // constructors return `self`, which is not a new object
+  currFunctionName = getConstructorName(currClassName);
+  if (env.isLiveFunction(currFunctionName)) {
+    getCurrSummary().effects.returnsNewObject = false;
+
+    auto& graph = env.coolContext.getInheritanceGraph();
+    const auto* parent = graph->getInheritanceNode(currClassName).getParent();
+    for (; parent != nullptr; parent = parent->getParent()) {
+      getCurrSummary().callees.insert(getConstructorName(parent->getNodeName()));
+    }
+
+    for (auto* attr : coolClass->getAttributes()->getData()) {
+      if (auto* member = llvm::dyn_cast<ast::SingleMember>(attr)) {
+        member->accept(this);
+      }
+    }
+  }
+
+  bool isDefaultClass = defaultClasses.find(currClassName) != defaultClasses.end();
+  if (not isDefaultClass) {
+    for (auto* attr : coolClass->getAttributes()->getData()) {
+      auto* method = llvm::dyn_cast<ast::SingleMethod>(attr);
+      if (method == nullptr) {
+        continue;
+      }
+      if (env.isLiveFunction(getMethodName(currClassName, method->getId()->getNameAsStr()))) {
+        method->accept(this);
+      }
+    }
+
+    for (auto& [idName, customized] : env.customizedMethods[currClassName]) {
+      visitMethodBody(getMethodName(currClassName, idName), customized.method);
+    }
+  }
+}
+
+void EffectAnalysis::visitSingleMember(ast::SingleMember* member) {
+  localVariables = {"self"};
+  member->getInitExpr()->accept(this);
+}
+
+void EffectAnalysis::visitSingleMethod(ast::SingleMethod* method) {
+  visitMethodBody(getMethodName(currClassName, method->getId()->getNameAsStr()), method);
+}
+
+void EffectAnalysis::visitMethodBody(const std::string& functionName, ast::SingleMethod* method) {
+  currFunctionName = functionName;
+  auto& returnTypeName = method->getReturnType()->getNameAsStr();
+  getCurrSummary().effects.hasImmutableResult = isImmutableType(returnTypeName);
+  // instrumented methods update their call records and heap profile counters
+  if ((not env.coolConfig.callProfileFile.empty()) ||
+      (not env.coolConfig.heapProfileFile.empty())) {
+    getCurrSummary().effects.readsMemory = true;
+    getCurrSummary().effects.writesMemory = true;
+  }
+
+  localVariables = {"self"};
+  for (auto* formal : method->getParameters()->getFormals()) {
+    localVariables.insert(formal->getId()->getNameAsStr());
+  }
+  method->getBody()->accept(this);
+}
+
+void EffectAnalysis::visitBlockExpr(ast::BlockExpr* block) { block->getExprs()->accept(this); }
+
+void EffectAnalysis::visitExpressions(ast::Expressions* exprs) {
+  for (auto* expr : exprs->getData()) {
+    expr->accept(this);
+  }
+}
+
+void EffectAnalysis::visitWhileLoop(ast::WhileLoop* loop) {
+  getCurrSummary().effects.mayNotReturn = true;
+  loop->getPredicate()->accept(this);
+  loop->getBody()->accept(this);
+}
+
+void EffectAnalysis::visitNegationNode(ast::NegationNode* node) {
+  getCurrSummary().effects.readsMemory = true;
+  node->getTerm()->accept(this);
+}
+
+void EffectAnalysis::visitPrimaryExpr(ast::PrimaryExpr* node) { node->getTerm()->accept(this); }
+
+void EffectAnalysis::visitIsVoidNode(ast::IsVoidNode* node) { node->getTerm()->accept(this); }
+
+void EffectAnalysis::visitNotExpr(ast::NotExpr* node) {
+  getCurrSummary().effects.readsMemory = true;
+  node->getExpr()->accept(this);
+}
+
+void EffectAnalysis::visitDispatch(ast::Dispatch* dispatch) {
+  auto staticTypeName = dispatch->getObjectId()->getSemantType()->getAsString();
+  auto& methodName = dispatch->getMethodId()->getNameAsStr();
+  auto candidates = getDispatchCandidates(resolveTypeName(staticTypeName), methodName);
+  visitDispatchSite(dispatch, dispatch->getObjectId(), dispatch->getArguments(), candidates);
+}
+
+void EffectAnalysis::visitStaticDispatch(ast::StaticDispatch* dispatch) {
+  auto& castTypeName = dispatch->getCastType()->getNameAsStr();
+  auto& methodName = dispatch->getMethodId()->getNameAsStr();
+
+  std::vector<std::string> candidates{};
+  auto methodId = dispatch->getMethodId()->getNameId();
+  if (auto data = env.globalMethodsTable[castTypeName].lookup(methodId)) {
+    auto& ownerName = data.value().owner->getCoolType()->getNameAsStr();
+    candidates.push_back(getMethodName(ownerName, methodName));
+  }
+  visitDispatchSite(dispatch, dispatch->getObjectId(), dispatch->getArguments(), candidates);
+}
+
+void EffectAnalysis::visitNewExpr(ast::NewExpr* newExpr) {
+  auto newTypeName = resolveTypeName(newExpr->getNewType()->getNameAsStr());
+  getCurrSummary().callees.insert(getConstructorName(newTypeName));
+}
+
+void EffectAnalysis::visitCaseExpr(ast::CaseExpr* caseExpr) {
+  // reads the class tag; prints an error and exits if no branch matches
+  getCurrSummary().effects.readsMemory = true;
+  getCurrSummary().effects.writesMemory = true;
+  getCurrSummary().effects.mayNotReturn = true;
+  caseExpr->getExpr()->accept(this);
+
+  for (auto* aCase : caseExpr->getCasses()->getData()) {
+    auto it = localVariables.insert(aCase->getId()->getNameAsStr());
+    aCase->getBody()->accept(this);
+    localVariables.erase(it);
+  }
+}
+
+void EffectAnalysis::visitPlusNode(ast::PlusNode* node) { visitBinaryNode(node); }
+void EffectAnalysis::visitMinusNode(ast::MinusNode* node) { visitBinaryNode(node); }
+void EffectAnalysis::visitMultiplyNode(ast::MultiplyNode* node) { visitBinaryNode(node); }
+void EffectAnalysis::visitDivideNode(ast::DivideNode* node) { visitBinaryNode(node); }
+void EffectAnalysis::visitLessNode(ast::LessNode* node) { visitBinaryNode(node); }
+void EffectAnalysis::visitLessEqualNode(ast::LessEqualNode* node) { visitBinaryNode(node); }
+void EffectAnalysis::visitEqualNode(ast::EqualNode* node) { visitBinaryNode(node); }
+
+void EffectAnalysis::visitBinaryNode(ast::BinaryExpression* node) {
+  getCurrSummary().effects.readsMemory = true;
+  node->getLeft()->accept(this);
+  node->getRight()->accept(this);
+}
+
+void EffectAnalysis::visitAssignExpr(ast::AssignExpr* node) {
+  node->getInitExpr()->accept(this);
+  auto& name = node->getId()->getNameAsStr();
+  if (localVariables.find(name) == localVariables.end()) {
+    getCurrSummary().effects.writesMemory = true;
+  }
+}
+
+void EffectAnalysis::visitIfThenExpr(ast::IfThenExpr* condExpr) {
+  getCurrSummary().effects.readsMemory = true;
+  condExpr->getCondition()->accept(this);
+  condExpr->getThenBody()->accept(this);
+}
+
+void EffectAnalysis::visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) {
+  getCurrSummary().effects.readsMemory = true;
+  condExpr->getCondition()->accept(this);
+  condExpr->getThenBody()->accept(this);
+  condExpr->getElseBody()->accept(this);
+}
+
+void EffectAnalysis::visitLetExpr(ast::LetExpr* letExpr) {
+  letExpr->getInitExpr()->accept(this);
+  auto it = localVariables.insert(letExpr->getId()->getNameAsStr());
+  letExpr->getBody()->accept(this);
+  localVariables.erase(it);
+}
+
+// locals and formals, like attributes, point to objects which are read by their uses, e.g.
+// every returned value goes through `Object_copy`
+void EffectAnalysis::visitObjectId(ast::ObjectId*) {
+  getCurrSummary().effects.readsMemory = true;
+}
+
+void EffectAnalysis::visitDispatchSite(ast::Node* dispatch,
+                                       ast::Node* receiver,
+                                       ast::Expressions* arguments,
+                                       std::vector<std::string> candidates) {
+  // loads the dispatch table and aborts on a void receiver
+  getCurrSummary().effects.readsMemory = true;
+  if (env.nonVoidReceivers.count(dispatch) == 0) {
+    getCurrSummary().effects.mayNotReturn = true;
+  }
+
+  receiver->accept(this);
+  arguments->accept(this);
+
+  getCurrSummary().callees.insert(candidates.begin(), candidates.end());
+  dispatchSites.push_back(DispatchSite{dispatch, std::move(candidates)});
+}
+
+std::vector<std::string> EffectAnalysis::getDispatchCandidates(const std::string& staticTypeName,
+                                                               const std::string& methodName) {
+  auto& graph = env.coolContext.getInheritanceGraph();
+  const auto& staticTypeNode = graph->getInheritanceNode(staticTypeName);
+
+  auto methodId = getSymbolId(methodName);
+  std::set<std::string> candidates{};
+  for (auto& [className, node] : graph->getNodes()) {
+    auto methodsTable = env.globalMethodsTable.find(className);
+    if ((not node.isChildOf(&staticTypeNode)) || (methodsTable == env.globalMethodsTable.end())) {
+      continue;
+    }
+    if (auto data = methodsTable->second.lookup(methodId)) {
+      auto candidate = getImplementationName(className, data.value());
+      if (env.isLiveFunction(candidate)) {
+        candidates.insert(candidate);
+      }
+    }
+  }
+  return std::vector<std::string>(candidates.begin(), candidates.end());
+}
+
+std::string EffectAnalysis::resolveTypeName(const std::string& typeName) {
+  return (typeName == "SELF_TYPE") ? currClassName : typeName;
+}
+
+void EffectAnalysis::markRecursiveFunctions() {
+  // a recursive call chain may not terminate
+  for (auto& [name, summary] : summaries) {
+    std::unordered_set<std::string> visited{};
+    std::vector<std::string> worklist(summary.callees.begin(), summary.callees.end());
+    while (not worklist.empty()) {
+      auto callee = worklist.back();
+      worklist.pop_back();
+      if (callee == name) {
+        summary.effects.mayNotReturn = true;
+        break;
+      }
+      if (not visited.insert(callee).second) {
+        continue;
+      }
+      auto it = summaries.find(callee);
+      if (it != summaries.end()) {
+        worklist.insert(worklist.end(), it->second.callees.begin(), it->second.callees.end());
+      }
+    }
+  }
+}
+
+void EffectAnalysis::propagateEffects() {
+  bool isChanged{true};
+  while (isChanged) {
+    isChanged = false;
+    for (auto& [name, summary] : summaries) {
+      for (auto& callee : summary.callees) {
+        auto it = summaries.find(callee);
+        if (it == summaries.end()) {
+          isChanged |= merge(summary.effects, MethodEffects{true, true, true});
+        } else {
+          isChanged |= merge(summary.effects, it->second.effects);
+        }
+      }
+    }
+  }
+}
+
+void EffectAnalysis::attachFunctionAttributes() {
+  for (auto& [name, effects] : env.methodEffects) {
+    if (auto* function = module->getFunction(name)) {
+      addEffectAttributes(function, effects);
+    }
+  }
+
+  // the same way as LLVM models `strdup`; a heap profile is updated by every copy
+  auto* copyObjectMethod = module->getFunction(getMethodName("Object", "copy"));
+  assert(copyObjectMethod != nullptr);
+  if (env.coolConfig.heapProfileFile.empty()) {
+    copyObjectMethod->setOnlyAccessesInaccessibleMemOrArgMem();
+  }
+  copyObjectMethod->addParamAttr(0, llvm::Attribute::ReadOnly);
+  copyObjectMethod->addParamAttr(0, llvm::Attribute::NoCapture);
+}
+} // namespace mcool::codegen
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "visitor.h"
+#include "CodeGen/BaseBuilder.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mcool::codegen {
+// Whole-program analysis which summarizes memory and termination effects of methods and
+// constructors, and of every dispatch over all methods it may reach (class hierarchy
+// analysis). The results are attached to LLVM functions and used for call sites.
+// Writes into a freshly allocated object are not counted as memory effects. Thus,
+// `readonly`/`readnone` are only given to methods which return immutable
+// objects (`Int`, `Bool` and `String`), for which merging two calls is not observable.
+class EffectAnalysis : public BaseBuilder, public ast::Visitor {
+  public:
+  explicit EffectAnalysis(Environment& env) : BaseBuilder(env) {}
+  void run(mcool::AstTree& classes);
+
+  private:
+  void visitCoolClass(ast::CoolClass* coolClass) override;
+  void visitSingleMember(ast::SingleMember* member) override;
+  void visitSingleMethod(ast::SingleMethod* method) override;
+  void visitBlockExpr(ast::BlockExpr* block) override;
+  void visitExpressions(ast::Expressions* exprs) override;
+  void visitWhileLoop(ast::WhileLoop* loop) override;
+  void visitNegationNode(ast::NegationNode* node) override;
+  void visitPrimaryExpr(ast::PrimaryExpr* node) override;
+  void visitIsVoidNode(ast::IsVoidNode* node) override;
+  void visitNotExpr(ast::NotExpr* node) override;
+  void visitDispatch(ast::Dispatch* dispatch) override;
+  void visitStaticDispatch(ast::StaticDispatch* dispatch) override;
+  void visitNewExpr(ast::NewExpr* newExpr) override;
+  void visitCaseExpr(ast::CaseExpr* caseExpr) override;
+  void visitPlusNode(ast::PlusNode* node) override;
+  void visitMinusNode(ast::MinusNode* node) override;
+  void visitMultiplyNode(ast::MultiplyNode* node) override;
+  void visitDivideNode(ast::DivideNode* node) override;
+  void visitLessNode(ast::LessNode* node) override;
+  void visitLessEqualNode(ast::LessEqualNode* node) override;
+  void visitEqualNode(ast::EqualNode* node) override;
+  void visitAssignExpr(ast::AssignExpr* node) override;
+  void visitIfThenExpr(ast::IfThenExpr* condExpr) override;
+  void visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) override;
+  void visitLetExpr(ast::LetExpr* letExpr) override;
+  void visitObjectId(ast::ObjectId* id) override;
+
+  struct Summary {
+    MethodEffects effects{};
+    std::unordered_set<std::string> callees{};
+  };
+
+  struct DispatchSite {
+    ast::Node* node{};
+    std::vector<std::string> candidates{};
+  };
+
+  void initBuiltinSummaries();
+  void visitMethodBody(const std::string& functionName, ast::SingleMethod* method);
+  void visitBinaryNode(ast::BinaryExpression* node);
+  void visitDispatchSite(ast::Node* dispatch,
+                         ast::Node* receiver,
+                         ast::Expressions* arguments,
+                         std::vector<std::string> candidates);
+  std::vector<std::string> getDispatchCandidates(const std::string& staticTypeName,
+                                                 const std::string& methodName);
+  std::string resolveTypeName(const std::string& typeName);
+  void markRecursiveFunctions();
+  void propagateEffects();
+  void attachFunctionAttributes();
+
+  Summary& getCurrSummary() { return summaries[currFunctionName]; }
+
+  std::unordered_map<std::string, Summary> summaries{};
+  std::vector<DispatchSite> dispatchSites{};
+
+  std::string currClassName{};
+  std::string currFunctionName{};
+  std::unordered_multiset<std::string> localVariables{};
+};
+} // namespace mcool::codegen
@@ -4,9 +4,12 @@
 #include "Context.h"
 #include "CodeGen/Definitions.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/DIBuilder.h"
 #include "llvm/IR/LLVMContext.h"
 #include <string>
 #include <memory>
+#include <unordered_set>
+#include <vector>
 
 namespace mcool::codegen {
 struct Environment {
@@ -28,11 +31,30 @@ struct Environment {
   std::unique_ptr<llvm::Module> llvmModule;
   std::unique_ptr<llvm::IRBuilder<>> llvmBuilder;
 
+  // debug info is emitted only if `llvmDIBuilder` is set
+  std::unique_ptr<llvm::DIBuilder> llvmDIBuilder{};
+  llvm::DICompileUnit* diCompileUnit{};
+  std::unordered_map<std::string, llvm::DIFile*> diFiles{};
+  std::unordered_map<std::string, llvm::DICompositeType*> diClassTypes{};
+
   GlobalMembersTable globalMembersTable{};
   GlobalMethodsTable globalMethodsTable{};
   GlobalSymbolTable globalSymbolTable{};
 
   std::unordered_map<std::string, int> classTagTable{};
+  std::unordered_set<ast::Node*> nonVoidReceivers{};
+  std::unordered_map<std::string, MethodEffects> methodEffects{};
+  std::unordered_map<ast::Node*, MethodEffects> dispatchEffects{};
+
+  std::unordered_set<std::string> liveFunctions{};
+  std::unordered_set<std::string> liveSelectors{};
+  std::unordered_set<std::string> instantiatedClasses{};
+  std::unordered_map<std::string, CustomizedMethods> customizedMethods{};
+  ReceiverProfile receiverProfile{};
+  std::vector<InstrumentedDispatchSite> instrumentedDispatchSites{};
+  std::vector<llvm::GlobalVariable*> callRecords{};
+  std::map<std::string, llvm::GlobalVariable*> heapSites{};
+  bool isLiveFunction(const std::string& name) { return liveFunctions.count(name) != 0; }
 
   enum class SystemType { CharPtrType, BytePtrType, SizeType };
   llvm::Type* getSystemType(SystemType index) { return systemTypes.at(index); }
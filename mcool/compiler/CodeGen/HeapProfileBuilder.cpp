@@ -0,0 +1,300 @@
+#include "CodeGen/HeapProfileBuilder.h"
+#include "CodeGen/Misc.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/IR/Verifier.h"
+
+namespace mcool::codegen {
+namespace {
+enum SiteField { Name = 0, Count, Bytes };
+constexpr size_t maxNumWrittenSites{20};
+} // namespace
+
+void HeapProfileBuilder::init() {
+  auto* charPtrType = env.getSystemType(Environment::SystemType::CharPtrType);
+  auto* counterType = builder->getInt64Ty();
+  auto* siteType = llvm::StructType::create(
+      *context, {charPtrType, counterType, counterType}, getHeapSiteTypeName());
+
+  auto* countersType = llvm::StructType::get(counterType, counterType);
+  auto* classCountersType = llvm::ArrayType::get(countersType, env.classTagTable.size());
+  new llvm::GlobalVariable(*module,
+                           classCountersType,
+                           false,
+                           llvm::GlobalValue::PrivateLinkage,
+                           llvm::ConstantAggregateZero::get(classCountersType),
+                           getHeapClassCountersName());
+
+  auto* unattributedSite = getHeapSite("<unattributed>");
+  new llvm::GlobalVariable(*module,
+                           siteType->getPointerTo(),
+                           false,
+                           llvm::GlobalValue::PrivateLinkage,
+                           unattributedSite,
+                           getHeapCurrentSiteName());
+
+  // `volatile sig_atomic_t`, set by the signal handler
+  new llvm::GlobalVariable(*module,
+                           builder->getInt32Ty(),
+                           false,
+                           llvm::GlobalValue::PrivateLinkage,
+                           builder->getInt32(0),
+                           getHeapProfileRequestName());
+
+  // the recorder calls the writer, whose body is generated once all sites are known
+  auto* writerType = llvm::FunctionType::get(builder->getVoidTy(), {}, false);
+  llvm::Function::Create(
+      writerType, llvm::Function::PrivateLinkage, getHeapProfileWriterName(), *module);
+
+  genRecorder();
+  genSignalHandler();
+}
+
+// adds an allocation to the counters of its site and class, and writes the profile if a signal
+// requested it
+void HeapProfileBuilder::genRecorder() {
+  auto* siteType = llvm::StructType::getTypeByName(*context, getHeapSiteTypeName());
+  auto* counterType = builder->getInt64Ty();
+  auto* funcType = llvm::FunctionType::get(
+      builder->getVoidTy(),
+      {siteType->getPointerTo(), builder->getInt32Ty(), counterType, counterType},
+      false);
+  auto* function = llvm::Function::Create(
+      funcType, llvm::Function::PrivateLinkage, getHeapRecorderName(), *module);
+
+  auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
+  builder->SetInsertPoint(entryBB);
+  auto* site = function->getArg(0);
+  auto* classTag = function->getArg(1);
+  auto* numBytes = function->getArg(2);
+  auto* numObjects = function->getArg(3);
+
+  auto addTo = [this](llvm::Value* address, llvm::Value* value) {
+    builder->CreateStore(builder->CreateAdd(builder->CreateLoad(address), value), address);
+  };
+  addTo(builder->CreateStructGEP(site, Count), numObjects);
+  addTo(builder->CreateStructGEP(site, Bytes), numBytes);
+
+  auto* classCounters = module->getGlobalVariable(getHeapClassCountersName(), true);
+  assert(classCounters != nullptr);
+  auto* zero = builder->getInt32(0);
+  addTo(builder->CreateInBoundsGEP(classCounters, {zero, classTag, builder->getInt32(0)}),
+        numObjects);
+  addTo(builder->CreateInBoundsGEP(classCounters, {zero, classTag, builder->getInt32(1)}),
+        numBytes);
+
+  auto* writeBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* exitBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* request = module->getGlobalVariable(getHeapProfileRequestName(), true);
+  assert(request != nullptr);
+  auto* isRequested = builder->CreateICmpNE(builder->CreateLoad(request, true), zero);
+  llvm::MDBuilder mdBuilder(*context);
+  builder->CreateCondBr(isRequested, writeBB, exitBB, mdBuilder.createBranchWeights(1, 1 << 20));
+
+  builder->SetInsertPoint(writeBB);
+  builder->CreateStore(zero, request, true);
+  auto* writer = module->getFunction(getHeapProfileWriterName());
+  assert(writer != nullptr);
+  builder->CreateCall(writer);
+  builder->CreateBr(exitBB);
+
+  builder->SetInsertPoint(exitBB);
+  builder->CreateRetVoid();
+  llvm::verifyFunction(*function, &(llvm::errs()));
+}
+
+// writes the counters of all classes and of the sites which allocated the most bytes; the sites
+// are sorted, thus the first unused one ends the list. The first profile of a run truncates
+// the file, later ones, e.g. requested by signals before the one at exit, are appended
+void HeapProfileBuilder::genProfileWriter() {
+  auto* siteType = llvm::StructType::getTypeByName(*context, getHeapSiteTypeName());
+  auto* sitePtrType = siteType->getPointerTo();
+  auto numSites = env.heapSites.size();
+  auto* sitesType = llvm::ArrayType::get(sitePtrType, numSites);
+  llvm::SmallVector<llvm::Constant*> sitePtrs{};
+  for (auto& [_, site] : env.heapSites) {
+    sitePtrs.push_back(site);
+  }
+  auto* sites = new llvm::GlobalVariable(*module,
+                                         sitesType,
+                                         false,
+                                         llvm::GlobalValue::PrivateLinkage,
+                                         llvm::ConstantArray::get(sitesType, sitePtrs),
+                                         getHeapSitesName());
+
+  auto* isWritten = new llvm::GlobalVariable(*module,
+                                             builder->getInt1Ty(),
+                                             false,
+                                             llvm::GlobalValue::PrivateLinkage,
+                                             builder->getFalse(),
+                                             getHeapProfileWrittenName());
+
+  auto* comparator = genSiteComparator();
+  auto* function = module->getFunction(getHeapProfileWriterName());
+  assert(function != nullptr);
+
+  auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
+  auto* classHeaderBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* classLoopBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* classBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* classWriteBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* classIncrementBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* siteHeaderBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* siteLoopBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* siteBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* siteWriteBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* closeBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* exitBB = llvm::BasicBlock::Create(*context, "", function);
+
+  builder->SetInsertPoint(entryBB);
+  auto& profileFile = env.coolConfig.heapProfileFile;
+  auto* fileName = builder->CreateGlobalStringPtr(profileFile, "", 0, module.get());
+  auto* isAppended = builder->CreateLoad(isWritten);
+  auto* mode = builder->CreateSelect(isAppended,
+                                     builder->CreateGlobalStringPtr("a", "", 0, module.get()),
+                                     builder->CreateGlobalStringPtr("w", "", 0, module.get()));
+  auto* fopenFunc = module->getFunction("fopen");
+  assert(fopenFunc != nullptr);
+  auto* file = builder->CreateCall(fopenFunc, {fileName, mode});
+  auto* filePtrType = llvm::cast<llvm::PointerType>(file->getType());
+  auto* isNull = builder->CreateICmpEQ(file, llvm::ConstantPointerNull::get(filePtrType));
+  builder->CreateCondBr(isNull, exitBB, classHeaderBB);
+
+  builder->SetInsertPoint(classHeaderBB);
+  builder->CreateStore(builder->getTrue(), isWritten);
+  auto* fprintfFunc = module->getFunction("fprintf");
+  assert(fprintfFunc != nullptr);
+  // appended profiles are separated by an empty line
+  auto* classHeader = builder->CreateGlobalStringPtr(
+      "\n#      objects            bytes  class\n", "", 0, module.get());
+  auto* firstClassHeader = builder->CreateInBoundsGEP(classHeader, builder->getInt64(1));
+  builder->CreateCall(fprintfFunc,
+                      {file, builder->CreateSelect(isAppended, classHeader, firstClassHeader)});
+  builder->CreateBr(classLoopBB);
+
+  builder->SetInsertPoint(classLoopBB);
+  auto* classTag = builder->CreatePHI(builder->getInt32Ty(), 2);
+  classTag->addIncoming(builder->getInt32(0), classHeaderBB);
+  auto* numClasses = builder->getInt32(env.classTagTable.size());
+  builder->CreateCondBr(builder->CreateICmpEQ(classTag, numClasses), siteHeaderBB, classBB);
+
+  builder->SetInsertPoint(classBB);
+  auto* classCounters = module->getGlobalVariable(getHeapClassCountersName(), true);
+  assert(classCounters != nullptr);
+  auto* zero = builder->getInt32(0);
+  auto* numObjects = builder->CreateLoad(
+      builder->CreateInBoundsGEP(classCounters, {zero, classTag, builder->getInt32(0)}));
+  auto* numBytes = builder->CreateLoad(
+      builder->CreateInBoundsGEP(classCounters, {zero, classTag, builder->getInt32(1)}));
+  auto* isUsed = builder->CreateICmpNE(numBytes, builder->getInt64(0));
+  builder->CreateCondBr(isUsed, classWriteBB, classIncrementBB);
+
+  builder->SetInsertPoint(classWriteBB);
+  auto* format = builder->CreateGlobalStringPtr("%14lu %16lu  %s\n", "", 0, module.get());
+  llvm::Value* classNameTable = module->getGlobalVariable(getClassNameTableName(), true);
+  assert(classNameTable != nullptr);
+  auto* className =
+      builder->CreateLoad(builder->CreateInBoundsGEP(classNameTable, {zero, classTag}));
+  builder->CreateCall(fprintfFunc, {file, format, numObjects, numBytes, className});
+  builder->CreateBr(classIncrementBB);
+
+  builder->SetInsertPoint(classIncrementBB);
+  classTag->addIncoming(builder->CreateAdd(classTag, builder->getInt32(1)), classIncrementBB);
+  builder->CreateBr(classLoopBB);
+
+  builder->SetInsertPoint(siteHeaderBB);
+  auto* bytePtrType = env.getSystemType(Environment::SystemType::BytePtrType);
+  auto* sitePtrSize = builder->getInt64(module->getDataLayout().getTypeAllocSize(sitePtrType));
+  auto* qsortFunc = module->getFunction("qsort");
+  assert(qsortFunc != nullptr);
+  builder->CreateCall(qsortFunc,
+                      {builder->CreateBitCast(sites, bytePtrType),
+                       builder->getInt64(numSites),
+                       sitePtrSize,
+                       comparator});
+  auto* siteHeader = builder->CreateGlobalStringPtr(
+      "\n#      objects            bytes  top allocation sites\n", "", 0, module.get());
+  builder->CreateCall(fprintfFunc, {file, siteHeader});
+  builder->CreateBr(siteLoopBB);
+
+  builder->SetInsertPoint(siteLoopBB);
+  auto* index = builder->CreatePHI(builder->getInt64Ty(), 2);
+  index->addIncoming(builder->getInt64(0), siteHeaderBB);
+  auto* numWrittenSites = builder->getInt64(std::min(numSites, maxNumWrittenSites));
+  auto* isDone = builder->CreateICmpEQ(index, numWrittenSites);
+  builder->CreateCondBr(isDone, closeBB, siteBB);
+
+  builder->SetInsertPoint(siteBB);
+  auto* siteAddress = builder->CreateInBoundsGEP(sites, {builder->getInt64(0), index});
+  auto* site = builder->CreateLoad(siteAddress);
+  auto loadField = [this, site](SiteField field) {
+    return builder->CreateLoad(builder->CreateStructGEP(site, field));
+  };
+  auto* siteBytes = loadField(Bytes);
+  auto* isUnused = builder->CreateICmpEQ(siteBytes, builder->getInt64(0));
+  builder->CreateCondBr(isUnused, closeBB, siteWriteBB);
+
+  builder->SetInsertPoint(siteWriteBB);
+  builder->CreateCall(fprintfFunc, {file, format, loadField(Count), siteBytes, loadField(Name)});
+  index->addIncoming(builder->CreateAdd(index, builder->getInt64(1)), siteWriteBB);
+  builder->CreateBr(siteLoopBB);
+
+  builder->SetInsertPoint(closeBB);
+  auto* fcloseFunc = module->getFunction("fclose");
+  assert(fcloseFunc != nullptr);
+  builder->CreateCall(fcloseFunc, file);
+  builder->CreateBr(exitBB);
+
+  builder->SetInsertPoint(exitBB);
+  builder->CreateRetVoid();
+  llvm::verifyFunction(*function, &(llvm::errs()));
+}
+
+// orders sites by bytes and then by objects; the greatest come first
+llvm::Function* HeapProfileBuilder::genSiteComparator() {
+  auto* bytePtrType = env.getSystemType(Environment::SystemType::BytePtrType);
+  auto* funcType =
+      llvm::FunctionType::get(builder->getInt32Ty(), {bytePtrType, bytePtrType}, false);
+  auto* function = llvm::Function::Create(
+      funcType, llvm::Function::PrivateLinkage, "_compare_heap_sites", *module);
+
+  auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
+  builder->SetInsertPoint(entryBB);
+
+  auto* siteType = llvm::StructType::getTypeByName(*context, getHeapSiteTypeName());
+  auto* sitePtrPtrType = siteType->getPointerTo()->getPointerTo();
+  auto* first = builder->CreateLoad(builder->CreateBitCast(function->getArg(0), sitePtrPtrType));
+  auto* second = builder->CreateLoad(builder->CreateBitCast(function->getArg(1), sitePtrPtrType));
+
+  llvm::Value* result = builder->getInt32(0);
+  for (auto field : {Bytes, Count}) {
+    auto* firstValue = builder->CreateLoad(builder->CreateStructGEP(first, field));
+    auto* secondValue = builder->CreateLoad(builder->CreateStructGEP(second, field));
+    auto* isLess = builder->CreateZExt(
+        builder->CreateICmpULT(firstValue, secondValue), builder->getInt32Ty());
+    auto* isGreater = builder->CreateZExt(
+        builder->CreateICmpUGT(firstValue, secondValue), builder->getInt32Ty());
+    auto* order = builder->CreateSub(isLess, isGreater);
+    auto* isOrdered = builder->CreateICmpNE(result, builder->getInt32(0));
+    result = builder->CreateSelect(isOrdered, result, order);
+  }
+  builder->CreateRet(result);
+  llvm::verifyFunction(*function, &(llvm::errs()));
+  return function;
+}
+
+// lets a running program write its profile, e.g. `kill -USR1 <pid>`; the handler only sets
+// a flag, which is async-signal-safe
+void HeapProfileBuilder::genSignalHandler() {
+  auto* funcType = llvm::FunctionType::get(builder->getVoidTy(), {builder->getInt32Ty()}, false);
+  auto* function = llvm::Function::Create(
+      funcType, llvm::Function::PrivateLinkage, getHeapProfileSignalHandlerName(), *module);
+
+  auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
+  builder->SetInsertPoint(entryBB);
+  auto* request = module->getGlobalVariable(getHeapProfileRequestName(), true);
+  assert(request != nullptr);
+  builder->CreateStore(builder->getInt32(1), request, true);
+  builder->CreateRetVoid();
+  llvm::verifyFunction(*function, &(llvm::errs()));
+}
+} // namespace mcool::codegen
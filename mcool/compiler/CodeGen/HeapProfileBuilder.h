@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CodeGen/BaseBuilder.h"
+
+namespace mcool::codegen {
+// Counts allocations and their bytes by class and by allocation site, see `--heap-profile`.
+// Every object is allocated by `Object_copy`; its callers set `HeapCurrentSite` right before
+// the call, thus `Object_copy` itself records the allocation. Copies requested through
+// a dispatch of `copy` are attributed to the unattributed site.
+// A signal handler only sets `HeapProfileRequest`; the next recorded allocation writes the
+// profile, because stdio and qsort must not run inside a handler.
+class HeapProfileBuilder : public BaseBuilder {
+  public:
+  explicit HeapProfileBuilder(Environment& env) : BaseBuilder(env) {}
+
+  bool isEnabled() { return not env.coolConfig.heapProfileFile.empty(); }
+  void init();
+  void genProfileWriter();
+
+  private:
+  void genRecorder();
+  llvm::Function* genSiteComparator();
+  void genSignalHandler();
+};
+} // namespace mcool::codegen
@@ -4,6 +4,7 @@
 #include "llvm/IR/Verifier.h"
 #include <vector>
 #include <map>
+#include <unordered_set>
 
 namespace mcool::codegen {
 std::vector<llvm::Type*> getCompulsoryTypes(Environment& env) {
@@ -44,10 +45,9 @@ void Initializer::genCoolClassTypes() {
       memberTypes.push_back(llvm::Type::getInt8PtrTy(*context));
     } else {
       auto& classMembersTable = env.globalMembersTable[coolClassName];
-      for (auto& scope : classMembersTable) {
-        auto classMembers = scope.values();
-        for (auto [member, _] : classMembers) {
-          auto memberTypeName = member->getIdType()->getNameAsStr();
+      for (auto scope : classMembersTable.getScopes()) {
+        for (auto& item : scope) {
+          auto& memberTypeName = item.value.member->getIdType()->getNameAsStr();
           auto* memberLLVMType = llvm::StructType::getTypeByName(*context, memberTypeName);
           auto* memberLLVMTypePtr = llvm::PointerType::get(memberLLVMType, 0);
           memberTypes.push_back(memberLLVMTypePtr);
@@ -81,9 +81,9 @@ MembersTable createMembersTable(std::vector<type::Graph::Node*>& inheritanceChai
     }
 
     for (auto* attr : childCoolClass->getAttributes()->getData()) {
-      if (auto* member = dynamic_cast<ast::SingleMember*>(attr)) {
+      if (auto* member = llvm::dyn_cast<ast::SingleMember>(attr)) {
         auto data = MembersTableData{member, offsetCounter};
-        membersTable.add(member->getId()->getNameAsStr(), data);
+        membersTable.add(member->getId()->getNameId(), data);
         addScope = true;
         ++offsetCounter;
       }
@@ -154,10 +154,9 @@ void Initializer::createGlobalVariable(ast::CoolClass* coolClass, const std::str
     constants.push_back(emptyString);
   } else {
     auto& classMembersTable = env.globalMembersTable[coolClassName];
-    for (auto& scope : classMembersTable) {
-      auto classMembers = scope.values();
-      for (auto [member, _] : classMembers) {
-        auto& memberName = member->getIdType()->getNameAsStr();
+    for (auto scope : classMembersTable.getScopes()) {
+      for (auto& item : scope) {
+        auto& memberName = item.value.member->getIdType()->getNameAsStr();
         auto* memberType = llvm::StructType::getTypeByName(*context, memberName);
         assert(memberType != nullptr);
         auto* memberTypePtr = llvm::PointerType::get(memberType, 0);
@@ -181,6 +180,9 @@ void Initializer::genCoolClassPrototypes() {
 
   for (auto* coolClass : classes.get()->getData()) {
     auto& coolClassName = coolClass->getCoolType()->getNameAsStr();
+    if (env.instantiatedClasses.count(coolClassName) == 0) {
+      continue;
+    }
     auto protoClassName = getProtoName(coolClassName);
     createGlobalVariable(coolClass, protoClassName);
   }
@@ -190,6 +192,9 @@ void Initializer::genConstructorDeclarations() {
   for (auto* coolClass : classes.get()->getData()) {
     auto& coolClassName = coolClass->getCoolType()->getNameAsStr();
     auto constructorName = getConstructorName(coolClassName);
+    if (not env.isLiveFunction(constructorName)) {
+      continue;
+    }
 
     auto* coolClassPtrType = getPtrType(coolClassName);
 
@@ -200,81 +205,76 @@ void Initializer::genConstructorDeclarations() {
   }
 }
 
+llvm::FunctionType* Initializer::getMethodType(const std::string& coolClassName,
+                                               ast::SingleMethod* method) {
+  auto* returnOpaqueType = getPtrType("Object");
+  auto& returnTypeName = method->getReturnType()->getNameAsStr();
+  auto* returnType =
+      (returnTypeName == "SELF_TYPE") ? returnOpaqueType : getPtrType(returnTypeName);
+  assert(returnType != nullptr);
+
+  auto* coolClassPtrType = getPtrType(coolClassName);
+  std::vector<llvm::Type*> argsTypes{coolClassPtrType};
+
+  for (auto* formal : method->getParameters()->getFormals()) {
+    auto& argTypeName = formal->getIdType()->getNameAsStr();
+    argsTypes.push_back(getPtrType(argTypeName));
+  }
+  return llvm::FunctionType::get(returnType, argsTypes, false);
+}
+
 void Initializer::genMethodDeclarations() {
   for (auto* coolClass : classes.get()->getData()) {
-    auto* returnOpaqueType = getPtrType("Object");
     auto coolClassName = coolClass->getCoolType()->getNameAsStr();
     for (auto* attr : coolClass->getAttributes()->getData()) {
-      if (auto* method = dynamic_cast<ast::SingleMethod*>(attr)) {
-
-        auto& returnTypeName = method->getReturnType()->getNameAsStr();
-        auto* returnType =
-            (returnTypeName == "SELF_TYPE") ? returnOpaqueType : getPtrType(returnTypeName);
-        assert(returnType != nullptr);
-
-        auto* coolClassPtrType = getPtrType(coolClassName);
-        std::vector<llvm::Type*> argsTypes{coolClassPtrType};
-
-        for (auto* formal : method->getParameters()->getFormals()) {
-          auto& argTypeName = formal->getIdType()->getNameAsStr();
-          argsTypes.push_back(getPtrType(argTypeName));
+      if (auto* method = llvm::dyn_cast<ast::SingleMethod>(attr)) {
+        auto methodName = getMethodName(coolClassName, method->getId()->getNameAsStr());
+        if (not env.isLiveFunction(methodName)) {
+          continue;
         }
 
-        auto methodName = getMethodName(coolClassName, method->getId()->getNameAsStr());
-        auto* funcType = llvm::FunctionType::get(returnType, argsTypes, false);
+        auto* funcType = getMethodType(coolClassName, method);
         auto* func = llvm::Function::Create(
             funcType, llvm::Function::InternalLinkage, methodName, module.get());
         func->setCallingConv(llvm::CallingConv::C);
       }
     }
+
+    for (auto& [idName, customized] : env.customizedMethods[coolClassName]) {
+      auto methodName = getMethodName(coolClassName, idName);
+      auto* funcType = getMethodType(coolClassName, customized.method);
+      auto* func = llvm::Function::Create(
+          funcType, llvm::Function::InternalLinkage, methodName, module.get());
+      func->setCallingConv(llvm::CallingConv::C);
+    }
   }
 }
 
-MethodsTable createMethodsTable(std::vector<type::Graph::Node*>& inheritanceChain) {
+// methods which are never dispatched on don't get a slot
+MethodsTable createMethodsTable(const type::ResolvedMethodTable& resolvedMethods,
+                                const std::unordered_set<std::string>& liveSelectors) {
   MethodsTable methodsTable;
   int offsetCounter{0};
-
-  bool addScope{false};
-  for (auto it = inheritanceChain.rbegin(); it != inheritanceChain.rend(); ++it) {
-    auto childCoolClass = (*it)->getCoolClass();
-
-    if (addScope) {
-      methodsTable.pushScope();
-      addScope = false;
-    }
-
-    for (auto* attr : childCoolClass->getAttributes()->getData()) {
-      if (auto* method = dynamic_cast<ast::SingleMethod*>(attr)) {
-        auto& methodName = method->getId()->getNameAsStr();
-        // TODO: maybe there is a better solution
-        if (auto result = methodsTable.lookup(methodName)) {
-          auto data = result.value();
-          data.owner = childCoolClass;
-          methodsTable[methodName] = data;
-        } else {
-          auto data = MethodsTableData{childCoolClass, method, offsetCounter};
-          methodsTable.add(method->getId()->getNameAsStr(), data);
-          ++offsetCounter;
-        }
-
-        addScope = true;
-      }
+  for (auto& resolved : resolvedMethods.getMethods()) {
+    if (liveSelectors.count(resolved.method->getId()->getNameAsStr()) == 0) {
+      continue;
     }
+    auto data = MethodsTableData{resolved.owner, resolved.method, offsetCounter};
+    methodsTable.add(resolved.name, data);
+    ++offsetCounter;
   }
   return methodsTable;
 }
 
 void Initializer::initGlobalMethodsTable() {
-  auto& coolContext = env.coolContext;
-  auto& graph = coolContext.getInheritanceGraph();
-
+  auto& resolvedMethodTables = env.coolContext.getResolvedMethods();
   for (auto* coolClass : classes.get()->getData()) {
     auto& coolClassName = coolClass->getCoolType()->getNameAsStr();
-    auto& coolClassNode = graph->getInheritanceNode(coolClassName);
-
-    std::vector<type::Graph::Node*> inheritanceChain{};
-    type::findInheritanceNodes(coolClassNode, inheritanceChain);
-    auto methodsTable = createMethodsTable(inheritanceChain);
+    auto& resolvedMethods = resolvedMethodTables.at(coolClassName);
+    auto methodsTable = createMethodsTable(resolvedMethods, env.liveSelectors);
+    for (auto& [methodName, _] : env.customizedMethods[coolClassName]) {
+      methodsTable[getSymbolId(methodName)].isCustomized = true;
+    }
     env.globalMethodsTable.insert({coolClassName, methodsTable});
   }
 }
@@ -290,15 +290,20 @@ void Initializer::genDispatchTables() {
     std::vector<llvm::Type*> functionTypes{};
     std::vector<llvm::Constant*> functionsPointers{};
     auto& methodsTable = env.globalMethodsTable[coolClassName];
-    for (auto& scope : methodsTable) {
+    for (auto scope : methodsTable.getScopes()) {
       for (auto& item : scope) {
-        auto& ownerName = item->owner->getCoolType()->getNameAsStr();
-        auto& methodName = item->method->getId()->getNameAsStr();
-        auto functionName = getMethodName(ownerName, methodName);
+        auto& ownerName = item.value.owner->getCoolType()->getNameAsStr();
+        auto functionName = getImplementationName(coolClassName, item.value);
         auto* function = module->getFunction(functionName);
 
-        if (function == nullptr)
-          continue; // TODO
+        // a method of a class which is never instantiated cannot be reached
+        if (function == nullptr) {
+          auto* methodType = getMethodType(ownerName, item.value.method);
+          auto* wrappedFunctionalPointer = llvm::PointerType::get(methodType, 0);
+          functionTypes.push_back(wrappedFunctionalPointer);
+          functionsPointers.push_back(llvm::ConstantPointerNull::get(wrappedFunctionalPointer));
+          continue;
+        }
 
         auto* wrappedFunctionalPointer = llvm::PointerType::get(function->getFunctionType(), 0);
         functionTypes.push_back(wrappedFunctionalPointer);
@@ -312,6 +317,7 @@ void Initializer::genDispatchTables() {
     auto* structConstant = llvm::ConstantStruct::get(dispTableType, functionsPointers);
     dispTable->setInitializer(structConstant);
     dispTable->setLinkage(llvm::GlobalValue::PrivateLinkage);
+    dispTable->setConstant(true);
   }
 }
 
@@ -340,5 +346,6 @@ void Initializer::initClassTagTable() {
   auto* constArray = llvm::ConstantArray::get(classNameTableType, constants);
   classNameTable->setInitializer(constArray);
   classNameTable->setLinkage(llvm::GlobalValue::PrivateLinkage);
+  classNameTable->setConstant(true);
 }
 } // namespace mcool::codegen
\ No newline at end of file
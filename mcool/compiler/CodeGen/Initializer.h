@@ -33,6 +33,7 @@ class Initializer : public BaseBuilder {
   void genCoolClassTypes();
   void genCoolClassPrototypes();
   void createGlobalVariable(ast::CoolClass* coolClass, const std::string& variableName);
+  llvm::FunctionType* getMethodType(const std::string& coolClassName, ast::SingleMethod* method);
 
   mcool::AstTree& classes;
   std::unordered_map<std::string, ast::CoolClass*> lookup{};
@@ -0,0 +1,189 @@
+#include "CodeGen/MethodCustomizer.h"
+#include "CodeGen/Misc.h"
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+namespace mcool::codegen {
+void MethodCustomizer::run(mcool::AstTree& classes) {
+  const static std::unordered_set<std::string> defaultClasses{
+      "Object", "IO", "Int", "String", "Bool"};
+
+  std::unordered_map<std::string, ast::CoolClass*> coolClasses{};
+  for (auto* coolClass : classes.get()->getData()) {
+    coolClasses.insert({coolClass->getCoolType()->getNameAsStr(), coolClass});
+  }
+
+  std::vector<Candidate> candidates{};
+  auto& graph = env.coolContext.getInheritanceGraph();
+  for (auto* coolClass : classes.get()->getData()) {
+    auto& className = coolClass->getCoolType()->getNameAsStr();
+    bool isDefaultClass = defaultClasses.find(className) != defaultClasses.end();
+    if (isDefaultClass || (env.instantiatedClasses.count(className) == 0)) {
+      continue;
+    }
+
+    // the first definition met on the way up is the one the class inherits
+    std::unordered_set<std::string> resolvedMethods{};
+    const auto* node = &graph->getInheritanceNode(className);
+    for (; node != nullptr; node = node->getParent()) {
+      auto& ownerName = node->getNodeName();
+      auto* owner = coolClasses.at(ownerName);
+      for (auto* attr : owner->getAttributes()->getData()) {
+        auto* method = llvm::dyn_cast<ast::SingleMethod>(attr);
+        if (method == nullptr) {
+          continue;
+        }
+
+        auto& methodName = method->getId()->getNameAsStr();
+        bool isInherited = resolvedMethods.insert(methodName).second && (ownerName != className);
+        bool isUserMethod = defaultClasses.find(ownerName) == defaultClasses.end();
+        bool isDispatched = (env.liveSelectors.count(methodName) != 0) &&
+                            env.isLiveFunction(getMethodName(ownerName, methodName));
+        if (isInherited && isUserMethod && isDispatched) {
+          auto& size = measure(method);
+          if (size.numSelfDispatches > 0) {
+            candidates.push_back(Candidate{className, CustomizedMethod{owner, method}, size});
+          }
+        }
+      }
+    }
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(), [](auto& first, auto& second) {
+    auto firstBenefit = first.size.numSelfDispatches * second.size.numNodes;
+    auto secondBenefit = second.size.numSelfDispatches * first.size.numNodes;
+    return firstBenefit > secondBenefit;
+  });
+
+  unsigned budget = env.coolConfig.customizationBudget;
+  for (auto& candidate : candidates) {
+    if (candidate.size.numNodes > budget) {
+      continue;
+    }
+    budget -= candidate.size.numNodes;
+
+    auto& methodName = candidate.customized.method->getId()->getNameAsStr();
+    env.customizedMethods[candidate.className].insert({methodName, candidate.customized});
+    env.liveFunctions.insert(getMethodName(candidate.className, methodName));
+  }
+}
+
+const MethodCustomizer::MethodSize& MethodCustomizer::measure(ast::SingleMethod* method) {
+  auto it = sizes.find(method);
+  if (it == sizes.end()) {
+    currSize = MethodSize{};
+    method->accept(this);
+    it = sizes.insert({method, currSize}).first;
+  }
+  return it->second;
+}
+
+void MethodCustomizer::visitSingleMethod(ast::SingleMethod* method) {
+  method->getBody()->accept(this);
+}
+
+void MethodCustomizer::visitBlockExpr(ast::BlockExpr* block) {
+  ++currSize.numNodes;
+  block->getExprs()->accept(this);
+}
+
+void MethodCustomizer::visitExpressions(ast::Expressions* exprs) {
+  for (auto* expr : exprs->getData()) {
+    expr->accept(this);
+  }
+}
+
+void MethodCustomizer::visitWhileLoop(ast::WhileLoop* loop) {
+  ++currSize.numNodes;
+  loop->getPredicate()->accept(this);
+  loop->getBody()->accept(this);
+}
+
+void MethodCustomizer::visitNegationNode(ast::NegationNode* node) {
+  ++currSize.numNodes;
+  node->getTerm()->accept(this);
+}
+
+void MethodCustomizer::visitPrimaryExpr(ast::PrimaryExpr* node) { node->getTerm()->accept(this); }
+
+void MethodCustomizer::visitIsVoidNode(ast::IsVoidNode* node) {
+  ++currSize.numNodes;
+  node->getTerm()->accept(this);
+}
+
+void MethodCustomizer::visitNotExpr(ast::NotExpr* node) {
+  ++currSize.numNodes;
+  node->getExpr()->accept(this);
+}
+
+void MethodCustomizer::visitDispatch(ast::Dispatch* dispatch) {
+  ++currSize.numNodes;
+  if (isSelfReference(dispatch->getObjectId())) {
+    ++currSize.numSelfDispatches;
+  }
+  dispatch->getObjectId()->accept(this);
+  dispatch->getArguments()->accept(this);
+}
+
+void MethodCustomizer::visitStaticDispatch(ast::StaticDispatch* dispatch) {
+  ++currSize.numNodes;
+  dispatch->getObjectId()->accept(this);
+  dispatch->getArguments()->accept(this);
+}
+
+void MethodCustomizer::visitNewExpr(ast::NewExpr*) { ++currSize.numNodes; }
+
+void MethodCustomizer::visitCaseExpr(ast::CaseExpr* caseExpr) {
+  ++currSize.numNodes;
+  caseExpr->getExpr()->accept(this);
+  for (auto* aCase : caseExpr->getCasses()->getData()) {
+    aCase->getBody()->accept(this);
+  }
+}
+
+void MethodCustomizer::visitPlusNode(ast::PlusNode* node) { visitBinaryNode(node); }
+void MethodCustomizer::visitMinusNode(ast::MinusNode* node) { visitBinaryNode(node); }
+void MethodCustomizer::visitMultiplyNode(ast::MultiplyNode* node) { visitBinaryNode(node); }
+void MethodCustomizer::visitDivideNode(ast::DivideNode* node) { visitBinaryNode(node); }
+void MethodCustomizer::visitLessNode(ast::LessNode* node) { visitBinaryNode(node); }
+void MethodCustomizer::visitLessEqualNode(ast::LessEqualNode* node) { visitBinaryNode(node); }
+void MethodCustomizer::visitEqualNode(ast::EqualNode* node) { visitBinaryNode(node); }
+
+void MethodCustomizer::visitBinaryNode(ast::BinaryExpression* node) {
+  ++currSize.numNodes;
+  node->getLeft()->accept(this);
+  node->getRight()->accept(this);
+}
+
+void MethodCustomizer::visitAssignExpr(ast::AssignExpr* node) {
+  ++currSize.numNodes;
+  node->getInitExpr()->accept(this);
+}
+
+void MethodCustomizer::visitIfThenExpr(ast::IfThenExpr* condExpr) {
+  ++currSize.numNodes;
+  condExpr->getCondition()->accept(this);
+  condExpr->getThenBody()->accept(this);
+}
+
+void MethodCustomizer::visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) {
+  ++currSize.numNodes;
+  condExpr->getCondition()->accept(this);
+  condExpr->getThenBody()->accept(this);
+  condExpr->getElseBody()->accept(this);
+}
+
+void MethodCustomizer::visitNoExpr(ast::NoExpr*) {}
+
+void MethodCustomizer::visitLetExpr(ast::LetExpr* letExpr) {
+  ++currSize.numNodes;
+  letExpr->getInitExpr()->accept(this);
+  letExpr->getBody()->accept(this);
+}
+
+void MethodCustomizer::visitObjectId(ast::ObjectId*) { ++currSize.numNodes; }
+void MethodCustomizer::visitBool(ast::Bool*) { ++currSize.numNodes; }
+void MethodCustomizer::visitInt(ast::Int*) { ++currSize.numNodes; }
+void MethodCustomizer::visitString(ast::String*) { ++currSize.numNodes; }
+} // namespace mcool::codegen
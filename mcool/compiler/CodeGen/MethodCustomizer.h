@@ -0,0 +1,65 @@
+#pragma once
+
+#include "visitor.h"
+#include "CodeGen/BaseBuilder.h"
+#include <string>
+#include <unordered_map>
+
+namespace mcool::codegen {
+// Clones inherited methods into instantiated subclasses. `self` has an exact type inside a
+// clone, thus dispatches on `self` become direct calls. Candidates with the most
+// self-dispatches per duplicated AST node are taken first until the code-size budget
+// (`--customization-budget`, in AST nodes) is spent.
+class MethodCustomizer : public BaseBuilder, public ast::Visitor {
+  public:
+  explicit MethodCustomizer(Environment& env) : BaseBuilder(env) {}
+  void run(mcool::AstTree& classes);
+
+  private:
+  void visitSingleMethod(ast::SingleMethod* method) override;
+  void visitBlockExpr(ast::BlockExpr* block) override;
+  void visitExpressions(ast::Expressions* exprs) override;
+  void visitWhileLoop(ast::WhileLoop* loop) override;
+  void visitNegationNode(ast::NegationNode* node) override;
+  void visitPrimaryExpr(ast::PrimaryExpr* node) override;
+  void visitIsVoidNode(ast::IsVoidNode* node) override;
+  void visitNotExpr(ast::NotExpr* node) override;
+  void visitDispatch(ast::Dispatch* dispatch) override;
+  void visitStaticDispatch(ast::StaticDispatch* dispatch) override;
+  void visitNewExpr(ast::NewExpr*) override;
+  void visitCaseExpr(ast::CaseExpr* caseExpr) override;
+  void visitPlusNode(ast::PlusNode* node) override;
+  void visitMinusNode(ast::MinusNode* node) override;
+  void visitMultiplyNode(ast::MultiplyNode* node) override;
+  void visitDivideNode(ast::DivideNode* node) override;
+  void visitLessNode(ast::LessNode* node) override;
+  void visitLessEqualNode(ast::LessEqualNode* node) override;
+  void visitEqualNode(ast::EqualNode* node) override;
+  void visitAssignExpr(ast::AssignExpr* node) override;
+  void visitIfThenExpr(ast::IfThenExpr* condExpr) override;
+  void visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) override;
+  void visitNoExpr(ast::NoExpr*) override;
+  void visitLetExpr(ast::LetExpr* letExpr) override;
+  void visitObjectId(ast::ObjectId*) override;
+  void visitBool(ast::Bool*) override;
+  void visitInt(ast::Int*) override;
+  void visitString(ast::String*) override;
+
+  struct MethodSize {
+    unsigned numNodes{0};
+    unsigned numSelfDispatches{0};
+  };
+
+  struct Candidate {
+    std::string className{};
+    CustomizedMethod customized{};
+    MethodSize size{};
+  };
+
+  void visitBinaryNode(ast::BinaryExpression* node);
+  const MethodSize& measure(ast::SingleMethod* method);
+
+  std::unordered_map<ast::SingleMethod*, MethodSize> sizes{};
+  MethodSize currSize{};
+};
+} // namespace mcool::codegen
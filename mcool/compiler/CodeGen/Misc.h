@@ -25,4 +25,48 @@ inline constexpr auto getClassNameTableName() { return "ClassNameTable"; }
 
 inline constexpr auto getClassNameTableTypeName() { return "ClassNameTable_type"; }
 
+inline constexpr auto getReceiverCountersName() { return "ReceiverCounters"; }
+
+inline constexpr auto getReceiverProfileWriterName() { return "_write_receiver_profile"; }
+
+inline std::string getCallRecordName(const std::string& functionName) {
+  return "CallRecord_" + functionName;
+}
+
+inline constexpr auto getCallRecordTypeName() { return "CallRecord"; }
+
+inline constexpr auto getCallRecordsName() { return "CallRecords"; }
+
+inline constexpr auto getCallChildCyclesName() { return "CallChildCycles"; }
+
+inline constexpr auto getCallProfileWriterName() { return "_write_call_profile"; }
+
+inline constexpr auto getHeapSiteTypeName() { return "HeapSite"; }
+
+inline constexpr auto getHeapSiteName() { return "HeapSite"; }
+
+inline constexpr auto getHeapSitesName() { return "HeapSites"; }
+
+inline constexpr auto getHeapCurrentSiteName() { return "HeapCurrentSite"; }
+
+inline constexpr auto getHeapClassCountersName() { return "HeapClassCounters"; }
+
+inline constexpr auto getHeapRecorderName() { return "_record_allocation"; }
+
+inline constexpr auto getHeapProfileWriterName() { return "_write_heap_profile"; }
+
+inline constexpr auto getHeapProfileSignalHandlerName() { return "_request_heap_profile"; }
+
+inline constexpr auto getHeapProfileRequestName() { return "HeapProfileRequest"; }
+
+inline constexpr auto getHeapProfileWrittenName() { return "HeapProfileWritten"; }
+
+inline std::string getRawIRProfileName(const std::string& profileFile) {
+  return profileFile + ".profraw";
+}
+
+inline std::string getIndexedIRProfileName(const std::string& profileFile) {
+  return profileFile + ".profdata";
+}
+
 } // namespace mcool::codegen
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "CodeGen/NullnessAnalysis.h"
+#include "llvm/Support/Casting.h"
+#include <cassert>
+
+namespace mcool::codegen {
+void NullnessAnalysis::run(mcool::AstTree& classes) {
+  for (auto* coolClass : classes.get()->getData()) {
+    coolClass->accept(this);
+  }
+}
+
+void NullnessAnalysis::visitCoolClass(ast::CoolClass* coolClass) {
+  const static std::unordered_set<std::string> defaultClasses{
+      "Object", "IO", "Int", "String", "Bool"};
+  auto& className = coolClass->getCoolType()->getNameAsStr();
+
+  bool isDefaultClass = defaultClasses.find(className) != defaultClasses.end();
+  if (not isDefaultClass) {
+    for (auto* attr : coolClass->getAttributes()->getData()) {
+      attr->accept(this);
+    }
+  }
+}
+
+void NullnessAnalysis::visitSingleMember(ast::SingleMember* member) {
+  nonVoidVariables = State{"self"};
+  member->getInitExpr()->accept(this);
+}
+
+void NullnessAnalysis::visitSingleMethod(ast::SingleMethod* method) {
+  nonVoidVariables = State{"self"};
+  for (auto* formal : method->getParameters()->getFormals()) {
+    nonVoidVariables.erase(formal->getId()->getNameAsStr());
+  }
+  method->getBody()->accept(this);
+}
+
+void NullnessAnalysis::visitBlockExpr(ast::BlockExpr* block) { block->getExprs()->accept(this); }
+
+void NullnessAnalysis::visitExpressions(ast::Expressions* exprs) {
+  isNonVoid = false;
+  for (auto* expr : exprs->getData()) {
+    expr->accept(this);
+  }
+}
+
+void NullnessAnalysis::visitWhileLoop(ast::WhileLoop* loop) {
+  // facts only grow along any path, so the state at the loop entry holds at every iteration
+  loop->getPredicate()->accept(this);
+  auto afterPredicate = nonVoidVariables;
+
+  nonVoidVariables = refine(afterPredicate, loop->getPredicate(), true);
+  loop->getBody()->accept(this);
+
+  nonVoidVariables = refine(afterPredicate, loop->getPredicate(), false);
+  isNonVoid = true;
+}
+
+void NullnessAnalysis::visitNegationNode(ast::NegationNode* node) {
+  node->getTerm()->accept(this);
+  isNonVoid = true;
+}
+
+void NullnessAnalysis::visitPrimaryExpr(ast::PrimaryExpr* node) { node->getTerm()->accept(this); }
+
+void NullnessAnalysis::visitIsVoidNode(ast::IsVoidNode* node) {
+  node->getTerm()->accept(this);
+  isNonVoid = true;
+}
+
+void NullnessAnalysis::visitNotExpr(ast::NotExpr* node) {
+  node->getExpr()->accept(this);
+  isNonVoid = true;
+}
+
+void NullnessAnalysis::visitDispatch(ast::Dispatch* dispatch) {
+  visitReceiver(dispatch->getObjectId(), dispatch);
+  for (auto* arg : dispatch->getArguments()->getData()) {
+    arg->accept(this);
+  }
+  // each method returns a fresh copy of its result
+  isNonVoid = true;
+}
+
+void NullnessAnalysis::visitStaticDispatch(ast::StaticDispatch* dispatch) {
+  visitReceiver(dispatch->getObjectId(), dispatch);
+  for (auto* arg : dispatch->getArguments()->getData()) {
+    arg->accept(this);
+  }
+  isNonVoid = true;
+}
+
+void NullnessAnalysis::visitNewExpr(ast::NewExpr*) { isNonVoid = true; }
+
+void NullnessAnalysis::visitCaseExpr(ast::CaseExpr* caseExpr) {
+  visitReceiver(caseExpr->getExpr(), caseExpr);
+  auto afterExpr = nonVoidVariables;
+
+  std::optional<State> mergedState{};
+  bool isResultNonVoid{true};
+  for (auto* aCase : caseExpr->getCasses()->getData()) {
+    nonVoidVariables = afterExpr;
+    visitBoundScope(aCase->getId()->getNameAsStr(), true, aCase->getBody());
+    isResultNonVoid = isResultNonVoid && isNonVoid;
+    mergedState = mergedState ? intersect(*mergedState, nonVoidVariables) : nonVoidVariables;
+  }
+
+  nonVoidVariables = mergedState.value_or(afterExpr);
+  isNonVoid = isResultNonVoid;
+}
+
+void NullnessAnalysis::visitPlusNode(ast::PlusNode* node) { visitBinaryNode(node); }
+void NullnessAnalysis::visitMinusNode(ast::MinusNode* node) { visitBinaryNode(node); }
+void NullnessAnalysis::visitMultiplyNode(ast::MultiplyNode* node) { visitBinaryNode(node); }
+void NullnessAnalysis::visitDivideNode(ast::DivideNode* node) { visitBinaryNode(node); }
+void NullnessAnalysis::visitLessNode(ast::LessNode* node) { visitBinaryNode(node); }
+void NullnessAnalysis::visitLessEqualNode(ast::LessEqualNode* node) { visitBinaryNode(node); }
+void NullnessAnalysis::visitEqualNode(ast::EqualNode* node) { visitBinaryNode(node); }
+
+void NullnessAnalysis::visitBinaryNode(ast::BinaryExpression* node) {
+  node->getRight()->accept(this);
+  node->getLeft()->accept(this);
+  isNonVoid = true;
+}
+
+void NullnessAnalysis::visitAssignExpr(ast::AssignExpr* node) {
+  node->getInitExpr()->accept(this);
+  if (isNonVoid) {
+    nonVoidVariables.insert(node->getId()->getNameAsStr());
+  }
+}
+
+void NullnessAnalysis::visitIfThenExpr(ast::IfThenExpr* condExpr) {
+  condExpr->getCondition()->accept(this);
+  auto afterCondition = nonVoidVariables;
+
+  nonVoidVariables = refine(afterCondition, condExpr->getCondition(), true);
+  condExpr->getThenBody()->accept(this);
+  auto thenState = nonVoidVariables;
+
+  // the else-branch yields a new default instance
+  auto elseState = refine(afterCondition, condExpr->getCondition(), false);
+  nonVoidVariables = intersect(thenState, elseState);
+}
+
+void NullnessAnalysis::visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) {
+  condExpr->getCondition()->accept(this);
+  auto afterCondition = nonVoidVariables;
+
+  nonVoidVariables = refine(afterCondition, condExpr->getCondition(), true);
+  condExpr->getThenBody()->accept(this);
+  auto thenState = nonVoidVariables;
+  bool isThenNonVoid = isNonVoid;
+
+  nonVoidVariables = refine(afterCondition, condExpr->getCondition(), false);
+  condExpr->getElseBody()->accept(this);
+
+  nonVoidVariables = intersect(thenState, nonVoidVariables);
+  isNonVoid = isThenNonVoid && isNonVoid;
+}
+
+void NullnessAnalysis::visitNoExpr(ast::NoExpr*) { isNonVoid = false; }
+
+void NullnessAnalysis::visitLetExpr(ast::LetExpr* letExpr) {
+  letExpr->getInitExpr()->accept(this);
+  visitBoundScope(letExpr->getId()->getNameAsStr(), isNonVoid, letExpr->getBody());
+}
+
+void NullnessAnalysis::visitObjectId(ast::ObjectId* id) {
+  isNonVoid = nonVoidVariables.find(id->getNameAsStr()) != nonVoidVariables.end();
+}
+
+void NullnessAnalysis::visitBool(ast::Bool*) { isNonVoid = true; }
+void NullnessAnalysis::visitInt(ast::Int*) { isNonVoid = true; }
+void NullnessAnalysis::visitString(ast::String*) { isNonVoid = true; }
+
+void NullnessAnalysis::visitReceiver(ast::Node* receiver, ast::Node* user) {
+  receiver->accept(this);
+  if (isNonVoid) {
+    env.nonVoidReceivers.insert(user);
+  }
+
+  // execution continues only if the null check has passed
+  if (auto name = getVariableName(receiver)) {
+    nonVoidVariables.insert(name.value());
+  }
+}
+
+void NullnessAnalysis::visitBoundScope(const std::string& name,
+                                       bool isBoundNonVoid,
+                                       ast::Node* body) {
+  bool wasNonVoid = nonVoidVariables.find(name) != nonVoidVariables.end();
+  if (isBoundNonVoid) {
+    nonVoidVariables.insert(name);
+  } else {
+    nonVoidVariables.erase(name);
+  }
+
+  body->accept(this);
+
+  if (wasNonVoid) {
+    nonVoidVariables.insert(name);
+  } else {
+    nonVoidVariables.erase(name);
+  }
+}
+
+NullnessAnalysis::State NullnessAnalysis::refine(const State& state,
+                                                 ast::Node* condition,
+                                                 bool isTrueBranch) {
+  // looks through `not` and parentheses for a test of the form `isvoid <variable>`
+  bool isVoidWhenTaken = isTrueBranch;
+  while (true) {
+    if (auto* primary = llvm::dyn_cast<ast::PrimaryExpr>(condition)) {
+      condition = primary->getTerm();
+    } else if (auto* notExpr = llvm::dyn_cast<ast::NotExpr>(condition)) {
+      condition = notExpr->getExpr();
+      isVoidWhenTaken = not isVoidWhenTaken;
+    } else {
+      break;
+    }
+  }
+
+  auto refinedState = state;
+  if (auto* isVoidNode = llvm::dyn_cast<ast::IsVoidNode>(condition)) {
+    auto name = getVariableName(isVoidNode->getTerm());
+    if (name && (not isVoidWhenTaken)) {
+      refinedState.insert(name.value());
+    }
+  }
+  return refinedState;
+}
+
+std::optional<std::string> NullnessAnalysis::getVariableName(ast::Node* node) {
+  while (auto* primary = llvm::dyn_cast<ast::PrimaryExpr>(node)) {
+    node = primary->getTerm();
+  }
+  if (auto* id = llvm::dyn_cast<ast::ObjectId>(node)) {
+    return id->getNameAsStr();
+  }
+  return std::nullopt;
+}
+
+NullnessAnalysis::State NullnessAnalysis::intersect(const State& first, const State& second) {
+  State result{};
+  for (auto& item : first) {
+    if (second.find(item) != second.end()) {
+      result.insert(item);
+    }
+  }
+  return result;
+}
+} // namespace mcool::codegen
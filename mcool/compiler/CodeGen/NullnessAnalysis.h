@@ -0,0 +1,65 @@
+#pragma once
+
+#include "visitor.h"
+#include "CodeGen/Environment.h"
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+namespace mcool::codegen {
+// Flow-sensitive analysis which finds dispatch and case receivers that can never be void.
+// It relies on the fact that every store into a variable goes through `Object_copy`, so a
+// variable which holds an object never becomes void again. Only let-bindings without an
+// initializer, members without an initializer and formals can be void.
+class NullnessAnalysis : public ast::Visitor {
+  public:
+  explicit NullnessAnalysis(Environment& env) : env(env) {}
+  void run(mcool::AstTree& classes);
+
+  private:
+  void visitCoolClass(ast::CoolClass* coolClass) override;
+  void visitSingleMember(ast::SingleMember* member) override;
+  void visitSingleMethod(ast::SingleMethod* method) override;
+  void visitBlockExpr(ast::BlockExpr* block) override;
+  void visitExpressions(ast::Expressions* exprs) override;
+  void visitWhileLoop(ast::WhileLoop* loop) override;
+  void visitNegationNode(ast::NegationNode* node) override;
+  void visitPrimaryExpr(ast::PrimaryExpr* node) override;
+  void visitIsVoidNode(ast::IsVoidNode* node) override;
+  void visitNotExpr(ast::NotExpr* node) override;
+  void visitDispatch(ast::Dispatch* dispatch) override;
+  void visitStaticDispatch(ast::StaticDispatch* dispatch) override;
+  void visitNewExpr(ast::NewExpr* newExpr) override;
+  void visitCaseExpr(ast::CaseExpr* caseExpr) override;
+  void visitPlusNode(ast::PlusNode* node) override;
+  void visitMinusNode(ast::MinusNode* node) override;
+  void visitMultiplyNode(ast::MultiplyNode* node) override;
+  void visitDivideNode(ast::DivideNode* node) override;
+  void visitLessNode(ast::LessNode* node) override;
+  void visitLessEqualNode(ast::LessEqualNode* node) override;
+  void visitEqualNode(ast::EqualNode* node) override;
+  void visitAssignExpr(ast::AssignExpr* node) override;
+  void visitIfThenExpr(ast::IfThenExpr* condExpr) override;
+  void visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) override;
+  void visitNoExpr(ast::NoExpr*) override;
+  void visitLetExpr(ast::LetExpr* letExpr) override;
+  void visitObjectId(ast::ObjectId* id) override;
+  void visitBool(ast::Bool*) override;
+  void visitInt(ast::Int*) override;
+  void visitString(ast::String*) override;
+
+  using State = std::unordered_set<std::string>;
+
+  void visitBinaryNode(ast::BinaryExpression* node);
+  void visitReceiver(ast::Node* receiver, ast::Node* user);
+  void visitBoundScope(const std::string& name, bool isBoundNonVoid, ast::Node* body);
+  State refine(const State& state, ast::Node* condition, bool isTrueBranch);
+
+  static std::optional<std::string> getVariableName(ast::Node* node);
+  static State intersect(const State& first, const State& second);
+
+  Environment& env;
+  State nonVoidVariables{};
+  bool isNonVoid{false};
+};
+} // namespace mcool::codegen
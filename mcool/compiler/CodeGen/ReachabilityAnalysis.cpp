@@ -0,0 +1,141 @@
+#include "CodeGen/ReachabilityAnalysis.h"
+#include "CodeGen/Misc.h"
+#include "llvm/Support/Casting.h"
+#include <cassert>
+
+namespace mcool::codegen {
+void ReachabilityAnalysis::run(mcool::AstTree& classes) {
+  for (auto* coolClass : classes.get()->getData()) {
+    auto& className = coolClass->getCoolType()->getNameAsStr();
+    coolClasses.insert({className, coolClass});
+    functions.insert({getConstructorName(className), FunctionSource{coolClass, nullptr}});
+
+    for (auto* attr : coolClass->getAttributes()->getData()) {
+      if (auto* method = llvm::dyn_cast<ast::SingleMethod>(attr)) {
+        auto functionName = getMethodName(className, method->getId()->getNameAsStr());
+        functions.insert({functionName, FunctionSource{coolClass, method}});
+      }
+    }
+  }
+
+  // literals and builtin methods produce basic objects, `main` creates `Main`
+  for (const auto* className : {"Int", "Bool", "String", "Main"}) {
+    instantiate(className);
+  }
+  markLive(getMethodName("Object", "copy"));
+  markLive(getMethodName("Main", "main"));
+
+  while (not worklist.empty()) {
+    while (not worklist.empty()) {
+      auto functionName = worklist.back();
+      worklist.pop_back();
+
+      auto& source = functions.at(functionName);
+      currClassName = source.coolClass->getCoolType()->getNameAsStr();
+      if (source.method != nullptr) {
+        visit(source.method);
+      } else {
+        for (auto* attr : source.coolClass->getAttributes()->getData()) {
+          if (auto* member = llvm::dyn_cast<ast::SingleMember>(attr)) {
+            visit(member);
+          }
+        }
+      }
+    }
+    resolveDispatchSites();
+  }
+}
+
+void ReachabilityAnalysis::visitWhileLoop(ast::WhileLoop* loop) {
+  // the result of a loop is a default instance of its type
+  instantiate(resolveTypeName(loop->getSemantType()->getAsString()));
+  visitChildren(loop);
+}
+
+void ReachabilityAnalysis::visitDispatch(ast::Dispatch* dispatch) {
+  visitChildren(dispatch);
+
+  auto staticTypeName = dispatch->getObjectId()->getSemantType()->getAsString();
+  auto& methodName = dispatch->getMethodId()->getNameAsStr();
+  env.liveSelectors.insert(methodName);
+  dispatchSites.insert({resolveTypeName(staticTypeName), methodName});
+}
+
+void ReachabilityAnalysis::visitStaticDispatch(ast::StaticDispatch* dispatch) {
+  visitChildren(dispatch);
+
+  auto& castTypeName = dispatch->getCastType()->getNameAsStr();
+  auto& methodName = dispatch->getMethodId()->getNameAsStr();
+  env.liveSelectors.insert(methodName);
+
+  auto ownerName = findOwner(castTypeName, methodName);
+  assert(ownerName.has_value());
+  markLive(getMethodName(ownerName.value(), methodName));
+}
+
+void ReachabilityAnalysis::visitNewExpr(ast::NewExpr* newExpr) {
+  instantiate(resolveTypeName(newExpr->getNewType()->getNameAsStr()));
+}
+
+void ReachabilityAnalysis::visitIfThenExpr(ast::IfThenExpr* condExpr) {
+  // the else-branch yields a default instance of the result type
+  instantiate(resolveTypeName(condExpr->getSemantType()->getAsString()));
+  visitChildren(condExpr);
+}
+
+void ReachabilityAnalysis::markLive(const std::string& functionName) {
+  bool isNew = env.liveFunctions.insert(functionName).second;
+  if (isNew && (functions.find(functionName) != functions.end())) {
+    worklist.push_back(functionName);
+  }
+}
+
+void ReachabilityAnalysis::instantiate(const std::string& className) {
+  bool isNew = env.instantiatedClasses.insert(className).second;
+  if (not isNew) {
+    return;
+  }
+
+  // constructors call the constructors of all parents
+  auto& graph = env.coolContext.getInheritanceGraph();
+  const auto* node = &graph->getInheritanceNode(className);
+  for (; node != nullptr; node = node->getParent()) {
+    markLive(getConstructorName(node->getNodeName()));
+  }
+}
+
+void ReachabilityAnalysis::resolveDispatchSites() {
+  auto& graph = env.coolContext.getInheritanceGraph();
+  for (auto& [staticTypeName, methodName] : dispatchSites) {
+    const auto& staticTypeNode = graph->getInheritanceNode(staticTypeName);
+    for (auto& className : env.instantiatedClasses) {
+      if (not graph->getInheritanceNode(className).isChildOf(&staticTypeNode)) {
+        continue;
+      }
+      if (auto ownerName = findOwner(className, methodName)) {
+        markLive(getMethodName(ownerName.value(), methodName));
+      }
+    }
+  }
+}
+
+std::optional<std::string> ReachabilityAnalysis::findOwner(const std::string& className,
+                                                           const std::string& methodName) {
+  auto& graph = env.coolContext.getInheritanceGraph();
+  const auto* node = &graph->getInheritanceNode(className);
+  for (; node != nullptr; node = node->getParent()) {
+    auto* coolClass = coolClasses.at(node->getNodeName());
+    for (auto* attr : coolClass->getAttributes()->getData()) {
+      auto* method = llvm::dyn_cast<ast::SingleMethod>(attr);
+      if ((method != nullptr) && (method->getId()->getNameAsStr() == methodName)) {
+        return node->getNodeName();
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::string ReachabilityAnalysis::resolveTypeName(const std::string& typeName) {
+  return (typeName == "SELF_TYPE") ? currClassName : typeName;
+}
+} // namespace mcool::codegen
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "static_visitor.h"
+#include "CodeGen/Environment.h"
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mcool::codegen {
+// Rapid type analysis rooted at `Main.main`. A method is live if some live dispatch may
+// reach it through a class which is instantiated by live code. Only live methods and
+// constructors get emitted, dispatch table slots are allocated only for method names which
+// are dispatched on, and prototypes are emitted only for instantiated classes.
+class ReachabilityAnalysis : public ast::RecursiveVisitor<ReachabilityAnalysis> {
+  public:
+  explicit ReachabilityAnalysis(Environment& env) : env(env) {}
+  void run(mcool::AstTree& classes);
+
+  private:
+  friend class ast::RecursiveVisitor<ReachabilityAnalysis>;
+
+  // the rest of the nodes only visit their children
+  void visitWhileLoop(ast::WhileLoop* loop);
+  void visitDispatch(ast::Dispatch* dispatch);
+  void visitStaticDispatch(ast::StaticDispatch* dispatch);
+  void visitNewExpr(ast::NewExpr* newExpr);
+  void visitIfThenExpr(ast::IfThenExpr* condExpr);
+
+  struct FunctionSource {
+    ast::CoolClass* coolClass{};
+    ast::SingleMethod* method{};
+  };
+
+  void markLive(const std::string& functionName);
+  void instantiate(const std::string& className);
+  void resolveDispatchSites();
+  std::optional<std::string> findOwner(const std::string& className,
+                                       const std::string& methodName);
+  std::string resolveTypeName(const std::string& typeName);
+
+  Environment& env;
+  std::unordered_map<std::string, ast::CoolClass*> coolClasses{};
+  std::unordered_map<std::string, FunctionSource> functions{};
+  std::set<std::pair<std::string, std::string>> dispatchSites{};
+  std::vector<std::string> worklist{};
+  std::string currClassName{};
+};
+} // namespace mcool::codegen
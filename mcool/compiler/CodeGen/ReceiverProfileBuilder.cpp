@@ -0,0 +1,139 @@
+#include "CodeGen/ReceiverProfileBuilder.h"
+#include "CodeGen/Misc.h"
+#include "llvm/IR/Verifier.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace mcool::codegen {
+bool ReceiverProfileBuilder::readProfile() {
+  auto& profileFile = env.coolConfig.profileUseFile;
+  std::fstream stream(profileFile, std::ios::in);
+  if (stream.fail()) {
+    std::cerr << "codegen error: cannot open profile file: `" << profileFile << "`\n";
+    return false;
+  }
+
+  std::string line{};
+  size_t lineNumber{0};
+  while (std::getline(stream, line)) {
+    ++lineNumber;
+    if (line.empty() || (line.front() == '#')) {
+      continue;
+    }
+
+    std::istringstream lineStream(line);
+    std::string siteName{};
+    std::string className{};
+    uint64_t count{0};
+    if (not(lineStream >> siteName >> className >> count)) {
+      std::cerr << "codegen error: malformed profile record at " << profileFile << ":"
+                << lineNumber << '\n';
+      return false;
+    }
+    env.receiverProfile[siteName][className] += count;
+  }
+  return true;
+}
+
+// writes non-zero counters of a single dispatch site; the counters are indexed by class tags
+llvm::Function* ReceiverProfileBuilder::genCountersWriter() {
+  auto* bytePtrType = env.getSystemType(Environment::SystemType::BytePtrType);
+  auto* charPtrType = env.getSystemType(Environment::SystemType::CharPtrType);
+  auto* countersPtrType = builder->getInt64Ty()->getPointerTo();
+  auto* funcType = llvm::FunctionType::get(
+      builder->getVoidTy(), {bytePtrType, charPtrType, countersPtrType}, false);
+  auto* function = llvm::Function::Create(
+      funcType, llvm::Function::PrivateLinkage, "_write_receiver_counters", *module);
+
+  auto* file = function->getArg(0);
+  auto* siteName = function->getArg(1);
+  auto* counters = function->getArg(2);
+
+  auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
+  auto* loopBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* countBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* writeBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* incrementBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* exitBB = llvm::BasicBlock::Create(*context, "", function);
+
+  builder->SetInsertPoint(entryBB);
+  builder->CreateBr(loopBB);
+
+  builder->SetInsertPoint(loopBB);
+  auto* classTag = builder->CreatePHI(builder->getInt32Ty(), 2);
+  classTag->addIncoming(builder->getInt32(0), entryBB);
+  auto* numClasses = builder->getInt32(env.classTagTable.size());
+  auto* isDone = builder->CreateICmpEQ(classTag, numClasses);
+  auto* counterAddress = builder->CreateInBoundsGEP(counters, classTag);
+  builder->CreateCondBr(isDone, exitBB, countBB);
+
+  builder->SetInsertPoint(countBB);
+  auto* count = builder->CreateLoad(counterAddress);
+  auto* isZero = builder->CreateICmpEQ(count, builder->getInt64(0));
+  builder->CreateCondBr(isZero, incrementBB, writeBB);
+
+  builder->SetInsertPoint(writeBB);
+  llvm::Value* classNameTable = module->getGlobalVariable(getClassNameTableName(), true);
+  assert(classNameTable != nullptr);
+  auto* classNameAddress =
+      builder->CreateInBoundsGEP(classNameTable, {builder->getInt32(0), classTag});
+  auto* className = builder->CreateLoad(classNameAddress);
+  auto* format = builder->CreateGlobalStringPtr("%s %s %lu\n", "", 0, module.get());
+  auto* fprintfFunc = module->getFunction("fprintf");
+  assert(fprintfFunc != nullptr);
+  builder->CreateCall(fprintfFunc, {file, format, siteName, className, count});
+  builder->CreateBr(incrementBB);
+
+  builder->SetInsertPoint(incrementBB);
+  auto* nextClassTag = builder->CreateAdd(classTag, builder->getInt32(1));
+  classTag->addIncoming(nextClassTag, incrementBB);
+  builder->CreateBr(loopBB);
+
+  builder->SetInsertPoint(exitBB);
+  builder->CreateRetVoid();
+  llvm::verifyFunction(*function, &(llvm::errs()));
+  return function;
+}
+
+void ReceiverProfileBuilder::genProfileWriter() {
+  auto* countersWriter = genCountersWriter();
+
+  auto* funcType = llvm::FunctionType::get(builder->getVoidTy(), {}, false);
+  auto* function = llvm::Function::Create(
+      funcType, llvm::Function::PrivateLinkage, getReceiverProfileWriterName(), *module);
+
+  auto* entryBB = llvm::BasicBlock::Create(*context, "entry", function);
+  auto* writeBB = llvm::BasicBlock::Create(*context, "", function);
+  auto* exitBB = llvm::BasicBlock::Create(*context, "", function);
+
+  builder->SetInsertPoint(entryBB);
+  auto& profileFile = env.coolConfig.profileGenerateFile;
+  auto* fileName = builder->CreateGlobalStringPtr(profileFile, "", 0, module.get());
+  auto* mode = builder->CreateGlobalStringPtr("w", "", 0, module.get());
+  auto* fopenFunc = module->getFunction("fopen");
+  assert(fopenFunc != nullptr);
+  auto* file = builder->CreateCall(fopenFunc, {fileName, mode});
+
+  auto* filePtrType = llvm::cast<llvm::PointerType>(file->getType());
+  auto* isNull = builder->CreateICmpEQ(file, llvm::ConstantPointerNull::get(filePtrType));
+  builder->CreateCondBr(isNull, exitBB, writeBB);
+
+  builder->SetInsertPoint(writeBB);
+  auto* countersPtrType = builder->getInt64Ty()->getPointerTo();
+  for (auto& site : env.instrumentedDispatchSites) {
+    auto* siteName = builder->CreateGlobalStringPtr(site.name, "", 0, module.get());
+    auto* counters = builder->CreateBitCast(site.counters, countersPtrType);
+    builder->CreateCall(countersWriter, {file, siteName, counters});
+  }
+
+  auto* fcloseFunc = module->getFunction("fclose");
+  assert(fcloseFunc != nullptr);
+  builder->CreateCall(fcloseFunc, file);
+  builder->CreateBr(exitBB);
+
+  builder->SetInsertPoint(exitBB);
+  builder->CreateRetVoid();
+  llvm::verifyFunction(*function, &(llvm::errs()));
+}
+} // namespace mcool::codegen
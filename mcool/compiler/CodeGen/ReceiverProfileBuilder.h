@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CodeGen/BaseBuilder.h"
+
+namespace mcool::codegen {
+// Reads and writes receiver-type profiles of dispatch sites. A profile is a text file with
+// one `<site> <class> <count>` line per class met at a site. A site is named after the
+// function which contains it and its ordinal number within that function, thus a profile
+// stays valid as long as the program and the code generation options stay the same.
+class ReceiverProfileBuilder : public BaseBuilder {
+  public:
+  explicit ReceiverProfileBuilder(Environment& env) : BaseBuilder(env) {}
+
+  bool readProfile();
+  void genProfileWriter();
+
+  private:
+  llvm::Function* genCountersWriter();
+};
+} // namespace mcool::codegen
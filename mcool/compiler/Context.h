@@ -3,6 +3,7 @@
 #include "MemoryManager.h"
 #include "Types/InheritanceGraph.h"
 #include "Types/TypeBuilder.h"
+#include "Types/Environment.h"
 #include <memory>
 #include <cassert>
 
@@ -19,10 +20,12 @@ class Context {
   const std::unique_ptr<type::Graph>& getInheritanceGraph() { return graph; }
   std::unique_ptr<type::TypeBuilder>& getTypeBulder() { return typeBuilder; }
   mcool::MemoryManager& getMemoryManager() { return memoryManager; }
+  type::ResolvedMethods& getResolvedMethods() { return resolvedMethods; }
 
   private:
   std::unique_ptr<type::Graph> graph{nullptr};
   std::unique_ptr<type::TypeBuilder> typeBuilder{nullptr};
   mcool::MemoryManager memoryManager{};
+  type::ResolvedMethods resolvedMethods{};
 };
 } // namespace mcool
\ No newline at end of file
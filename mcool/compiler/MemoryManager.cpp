@@ -1,23 +1,49 @@
 #include "MemoryManager.h"
 
 namespace mcool {
-  MemoryManager::~MemoryManager() {
-  for (auto ptr : memory) {
-    std::free(ptr);
+ast::Int* MemoryManager::getIntNode(const int& integer) {
+  auto it = integerTable.find(integer);
+  if (it == integerTable.end()) {
+    it = integerTable.insert({integer, arena.create<ast::Int>(integer)}).first;
+    countNode(it->second);
   }
+  return it->second;
 }
 
-ast::Int* MemoryManager::getIntNode(const int& integer) {
-  if (integerTable.find(integer) == integerTable.end()) {
-    integerTable.insert({integer, std::make_unique<ast::Int>(integer)});
+ast::Bool* MemoryManager::getBoolNode(const bool& boolean) {
+  auto it = booleanTable.find(boolean);
+  if (it == booleanTable.end()) {
+    it = booleanTable.insert({boolean, arena.create<ast::Bool>(boolean)}).first;
+    countNode(it->second);
   }
-  return integerTable[integer].get();
+  return it->second;
 }
 
-ast::Bool* MemoryManager::getBoolNode(const bool& boolean) {
-  if (booleanTable.find(boolean) == booleanTable.end()) {
-    booleanTable.insert({boolean, std::make_unique<ast::Bool>(boolean)});
+std::vector<std::string> MemoryManager::getStaticStrings() const {
+  std::vector<std::string> staticStrings{};
+  for (SymbolId id = 0; id < strings.size(); ++id) {
+    if (stringKinds[id] & StringKind::Static) {
+      staticStrings.push_back(strings.get(id)->get());
+    }
+  }
+  return staticStrings;
+}
+
+MemoryManager::StringTableSizes MemoryManager::getStringTableSizes() const {
+  StringTableSizes sizes{};
+  for (auto kinds : stringKinds) {
+    sizes.staticStrings += (kinds & StringKind::Static) ? 1 : 0;
+    sizes.objectStrings += (kinds & StringKind::Object) ? 1 : 0;
+    sizes.rawStrings += (kinds & StringKind::Raw) ? 1 : 0;
+  }
+  return sizes;
+}
+
+std::map<std::string, size_t> MemoryManager::getNodeCounts() const {
+  std::map<std::string, size_t> counts{};
+  for (auto& [className, count] : nodeCounts) {
+    counts[*className] += count;
   }
-  return booleanTable[boolean].get();
+  return counts;
 }
 } // namespace mcool
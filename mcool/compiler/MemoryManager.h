@@ -1,9 +1,13 @@
 #pragma once
 
+#include "Arena.h"
+#include "StringInterner.h"
 #include "ast.h"
+#include <map>
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 #include <type_traits>
@@ -13,51 +17,74 @@ class MemoryManager {
   public:
   MemoryManager() = default;
   MemoryManager(MemoryManager&& other) = default;
-  ~MemoryManager();
 
   template <typename Type, typename... Args>
   Type* make(Args... args);
 
-  void obtain(void* ptr) { memory.push_back(ptr); }
-
   template <typename Type>
   std::enable_if_t<std::is_same_v<Type, ast::String> || std::is_same_v<Type, ast::TypeId> ||
                        std::is_same_v<Type, ast::ObjectId> || std::is_same_v<Type, ast::StringPtr>,
                    ast::StringPtr*>
-      getStringPtr(std::string& str) {
-    std::unordered_map<std::string, std::unique_ptr<ast::StringPtr>>* table;
+      getStringPtr(std::string_view str) {
+    StringKind kind{};
     if constexpr (std::is_same_v<Type, ast::String> || std::is_same_v<Type, ast::TypeId>) {
-      table = &staticStringTable;
+      kind = StringKind::Static;
     } else if constexpr (std::is_same_v<Type, ast::StringPtr>) {
-      table = &rawStringTable;
+      kind = StringKind::Raw;
     } else {
-      table = &objectStringTable;
+      kind = StringKind::Object;
     }
-    if (table->find(str) == table->end()) {
-      table->insert({str, std::make_unique<ast::StringPtr>(str)});
+    auto* ptr = strings.intern(str);
+    if (ptr->getId() == stringKinds.size()) {
+      stringKinds.push_back(0);
     }
-    return (table->operator[](str)).get();
+    stringKinds[ptr->getId()] |= kind;
+    return ptr;
   }
+  const StringInterner& getStrings() const { return strings; }
+  // ids of names which the compiler refers to, e.g. `self`
+  SymbolId getSymbolId(std::string_view name) { return getStringPtr<ast::ObjectId>(name)->getId(); }
 
   ast::Int* getIntNode(const int& integer);
   ast::Bool* getBoolNode(const bool& boolean);
 
-  auto getStaticStrings() {
-    std::vector<std::string> strings{};
-    for (auto& item : staticStringTable) {
-      strings.push_back(item.first);
+  std::vector<std::string> getStaticStrings() const;
+
+  struct StringTableSizes {
+    size_t staticStrings{0};
+    size_t objectStrings{0};
+    size_t rawStrings{0};
+  };
+  StringTableSizes getStringTableSizes() const;
+  std::map<std::string, size_t> getNodeCounts() const;
+  size_t getNodeBytes() const { return nodeBytes; }
+  size_t getArenaBytes() const { return arena.getAllocatedBytes(); }
+  size_t getNumArenaSlabs() const { return arena.getNumSlabs(); }
+
+  private:
+  template <typename Type>
+  void countNode(Type* node) {
+    if constexpr (std::is_base_of_v<ast::Node, Type>) {
+      ++nodeCounts[&(node->getClassName())];
+      nodeBytes += sizeof(Type);
     }
-    return strings;
   }
 
-  private:
-  std::unordered_map<std::string, std::unique_ptr<ast::StringPtr>> staticStringTable{};
-  std::unordered_map<std::string, std::unique_ptr<ast::StringPtr>> rawStringTable{};
-  std::unordered_map<std::string, std::unique_ptr<ast::StringPtr>> objectStringTable{};
-  std::unordered_map<int, std::unique_ptr<ast::Int>> integerTable{};
-  std::unordered_map<bool, std::unique_ptr<ast::Bool>> booleanTable{};
-  std::vector<void*> memory{};
+  // a string may be interned as several kinds; they share a single `StringPtr`
+  enum StringKind : uint8_t { Static = 1, Object = 2, Raw = 4 };
+
+  StringInterner strings{};
+  std::vector<uint8_t> stringKinds{};
+  std::unordered_map<int, ast::Int*> integerTable{};
+  std::unordered_map<bool, ast::Bool*> booleanTable{};
   int classTagCounter{0};
+
+  // keyed by the static class names of nodes; interned nodes are counted once
+  std::unordered_map<const std::string*, size_t> nodeCounts{};
+  size_t nodeBytes{0};
+
+  // nodes follow the interning tables, so that they are destroyed first
+  Arena arena{};
 };
 
 template <typename Type, typename... Args>
@@ -68,22 +95,19 @@ Type* MemoryManager::make(Args... args) {
     using FirstParamType = std::tuple_element_t<0, std::tuple<Args...>>;
     static_assert(sizeof...(args) == 1 && std::is_same_v<FirstParamType, std::string>,
                   "expected std::string as parameter");
-    auto param = std::get<0>(std::make_tuple(args...));
-    auto stringPtr = this->getStringPtr<Type>(param);
-    ptr = new Type(stringPtr);
+    auto stringPtr = this->getStringPtr<Type>(std::get<0>(std::forward_as_tuple(args...)));
+    ptr = arena.create<Type>(stringPtr);
+    countNode(ptr);
   } else if constexpr (std::is_same_v<Type, ast::Int>) {
     ptr = this->getIntNode(args...);
   } else if constexpr (std::is_same_v<Type, ast::Bool>) {
     ptr = this->getBoolNode(args...);
   } else if constexpr(std::is_same_v<Type, ast::CoolClass>) {
-    ptr = new Type(args..., classTagCounter++);
-    this->obtain(static_cast<void*>(ptr));
-  } else if constexpr (sizeof...(args)) {
-    ptr = new Type(args...);
-    this->obtain(static_cast<void*>(ptr));
+    ptr = arena.create<Type>(args..., classTagCounter++);
+    countNode(ptr);
   } else {
-    ptr = new Type();
-    this->obtain(static_cast<void*>(ptr));
+    ptr = arena.create<Type>(args...);
+    countNode(ptr);
   }
   return ptr;
 }
@@ -24,6 +24,37 @@ Config readCmd(int argc, char* argv[]) {
   auto* emitLLVMIr = cmd.add_flag("--emit-llvm-ir", "emits llvm ir");
   auto* writeAsmOutput = cmd.add_flag("--asm", "write output in the assembly language");
   auto* verboseOption = cmd.add_flag("-v,--verbose", "verbose mode");
+  auto* debugInfoOption = cmd.add_flag("-g,--debug-info", "emit debug information");
+  auto* lineTablesOnlyOption =
+      cmd.add_flag("--line-tables-only", "emit debug line tables only (no types and variables)");
+  auto* timePhasesOption =
+      cmd.add_flag("--time-phases", "print wall and cpu time of compiler phases and llvm passes");
+  auto* statsOption =
+      cmd.add_flag("--stats", "print sizes of compiler data structures and of the generated code");
+  auto* statsJsonOption = cmd.add_flag("--stats-json", "print the statistics of --stats as json");
+  cmd.add_option("-O,--opt-level", config.optLevel, "llvm ir optimization level")
+      ->check(CLI::Range(0, 3));
+  cmd.add_option("--customization-budget",
+                 config.customizationBudget,
+                 "max number of ast nodes which method customization may duplicate");
+  cmd.add_option("--profile-generate",
+                 config.profileGenerateFile,
+                 "instrument the program to write receiver-type and llvm ir profiles at exit");
+  cmd.add_option("--profile-use",
+                 config.profileUseFile,
+                 "optimize the program using profiles of a training run");
+  cmd.add_option("--opt-remarks",
+                 config.optRemarksFile,
+                 "write llvm and mcool optimization remarks to the file (yaml)");
+  cmd.add_option("--instrument-calls",
+                 config.callProfileFile,
+                 "count calls and cycles of methods and write them to the file at exit");
+  cmd.add_option("--heap-profile",
+                 config.heapProfileFile,
+                 "count allocations by class and site and write them to the file at exit");
+  cmd.add_option("--trace-json",
+                 config.traceJsonFile,
+                 "write compiler phases and llvm passes as chrome trace events to the file");
 
   try {
     cmd.parse(argc, argv);
@@ -74,6 +105,23 @@ Config readCmd(int argc, char* argv[]) {
     config.verbose = true;
   }
 
+  if (*debugInfoOption) {
+    config.emitDebugInfo = true;
+  }
+
+  if (*lineTablesOnlyOption) {
+    config.lineTablesOnly = true;
+  }
+
+  if (*timePhasesOption) {
+    config.timePhases = true;
+  }
+
+  if (*statsOption || *statsJsonOption) {
+    config.printStats = true;
+    config.printStatsAsJson = static_cast<bool>(*statsJsonOption);
+  }
+
   return config;
 }
 
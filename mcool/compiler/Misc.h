@@ -18,6 +18,19 @@ struct Config {
   bool emitLLVMIr{false};
   bool writeAsmOutput{false};
   bool verbose{false};
+  bool emitDebugInfo{false};
+  bool lineTablesOnly{false};
+  bool timePhases{false};
+  bool printStats{false};
+  bool printStatsAsJson{false};
+  unsigned optLevel{0};
+  unsigned customizationBudget{0};
+  std::string profileGenerateFile{};
+  std::string profileUseFile{};
+  std::string optRemarksFile{};
+  std::string callProfileFile{};
+  std::string heapProfileFile{};
+  std::string traceJsonFile{};
 };
 
 Config readCmd(int argc, char* argv[]);
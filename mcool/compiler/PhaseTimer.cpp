@@ -0,0 +1,86 @@
+#include "PhaseTimer.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/Error.h"
+#include <iomanip>
+#include <iostream>
+
+namespace mcool::misc {
+PhaseTimer* PhaseTimer::instance{nullptr};
+
+PhaseTimer::PhaseTimer(const Config& config) : config(config) {
+  if ((not config.timePhases) && config.traceJsonFile.empty()) {
+    return;
+  }
+  instance = this;
+  if (not config.traceJsonFile.empty()) {
+    llvm::timeTraceProfilerInitialize(0, "mcool");
+  }
+}
+
+PhaseTimer::~PhaseTimer() {
+  if (instance != this) {
+    return;
+  }
+  instance = nullptr;
+
+  if (config.timePhases) {
+    print(std::cerr);
+  }
+
+  if (llvm::timeTraceProfilerEnabled()) {
+    auto error = llvm::timeTraceProfilerWrite(config.traceJsonFile, config.outputFile);
+    if (error) {
+      std::cerr << "cannot write trace file: `" << config.traceJsonFile
+                << "`: " << llvm::toString(std::move(error)) << '\n';
+    }
+    llvm::timeTraceProfilerCleanup();
+  }
+}
+
+void PhaseTimer::print(std::ostream& stream) {
+  constexpr int columnWidth{12};
+  stream << "===== compiler phases =====\n";
+  stream << std::setw(columnWidth) << "wall (ms)" << std::setw(columnWidth) << "cpu (ms)"
+         << "  phase\n";
+  stream << std::fixed << std::setprecision(3);
+  for (auto& phase : phases) {
+    stream << std::setw(columnWidth) << phase.wallTime << std::setw(columnWidth) << phase.cpuTime
+           << "  " << std::string(2 * phase.depth, ' ') << phase.name << '\n';
+  }
+  stream.unsetf(std::ios::fixed);
+}
+
+// a phase takes its place in the report when it begins, thus sub-phases follow their parents
+ScopedPhase::ScopedPhase(const char* name) {
+  auto* timer = PhaseTimer::instance;
+  if (timer == nullptr) {
+    return;
+  }
+  index = timer->phases.size();
+  timer->phases.push_back(PhaseTimer::Phase{name, timer->depth, 0.0, 0.0});
+  ++timer->depth;
+
+  if (llvm::timeTraceProfilerEnabled()) {
+    llvm::timeTraceProfilerBegin(name, "");
+  }
+  wallStart = std::chrono::steady_clock::now();
+  cpuStart = std::clock();
+}
+
+ScopedPhase::~ScopedPhase() {
+  auto* timer = PhaseTimer::instance;
+  if (timer == nullptr) {
+    return;
+  }
+  auto cpuEnd = std::clock();
+  auto wallEnd = std::chrono::steady_clock::now();
+  if (llvm::timeTraceProfilerEnabled()) {
+    llvm::timeTraceProfilerEnd();
+  }
+
+  auto& phase = timer->phases[index];
+  phase.wallTime = std::chrono::duration<double, std::milli>(wallEnd - wallStart).count();
+  phase.cpuTime = 1000.0 * static_cast<double>(cpuEnd - cpuStart) / CLOCKS_PER_SEC;
+  --timer->depth;
+}
+} // namespace mcool::misc
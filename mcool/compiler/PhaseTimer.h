@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Misc.h"
+#include <chrono>
+#include <ctime>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mcool::misc {
+// Measures wall and cpu time of compiler phases, see `--time-phases` and `--trace-json`.
+// Phases nest the same way as their scopes; every phase is also recorded as a trace event
+// together with the events of LLVM passes.
+class PhaseTimer {
+  public:
+  explicit PhaseTimer(const Config& config);
+  ~PhaseTimer();
+
+  static bool isEnabled() { return instance != nullptr; }
+
+  private:
+  friend class ScopedPhase;
+  struct Phase {
+    std::string name{};
+    unsigned depth{0};
+    double wallTime{0.0};
+    double cpuTime{0.0};
+  };
+
+  void print(std::ostream& stream);
+
+  static PhaseTimer* instance;
+  const Config& config;
+  std::vector<Phase> phases{};
+  unsigned depth{0};
+};
+
+class ScopedPhase {
+  public:
+  explicit ScopedPhase(const char* name);
+  ~ScopedPhase();
+
+  private:
+  size_t index{0};
+  std::chrono::steady_clock::time_point wallStart{};
+  std::clock_t cpuStart{};
+};
+} // namespace mcool::misc
@@ -1,4 +1,5 @@
 #include "Semant/EntryPointChecker.h"
+#include "llvm/Support/Casting.h"
 
 namespace mcool::semant {
 void EntryPointChecker::run(ast::CoolClassList* coolClassList) {
@@ -45,7 +46,7 @@ bool EntryPointChecker::assertSingleMainClass(ast::CoolClassList* coolClassList)
 bool EntryPointChecker::assertSingleMainMethod() {
   std::vector<mcool::ast::SingleMethod*> mainMethods{};
   for (auto* attr : mainClass->getAttributes()->getData()) {
-    if (auto* method = dynamic_cast<mcool::ast::SingleMethod*>(attr)) {
+    if (auto* method = llvm::dyn_cast<mcool::ast::SingleMethod>(attr)) {
       auto& methodName = method->getId()->getNameAsStr();
       if (methodName == "main") {
         mainMethods.push_back(method);
@@ -4,12 +4,13 @@
 namespace mcool::semant {
 type::TypeEnvironments EnvironmentsBuilder::build(ast::CoolClassList* coolClassList) {
   typeEnvironment = type::TypeEnvironments();
+  context.getResolvedMethods().clear();
   collectMethodAndAttrs(coolClassList->getData());
   inflateClassEnv(coolClassList->getData());
   return std::move(typeEnvironment);
 }
 
-void EnvironmentsBuilder::collectMethodAndAttrs(std::list<ast::CoolClass*>& coolClasses) {
+void EnvironmentsBuilder::collectMethodAndAttrs(ast::NodeList<ast::CoolClass*>& coolClasses) {
   for (auto* coolClass : coolClasses) {
     auto& className = coolClass->getCoolType()->getNameAsStr();
 
@@ -27,10 +28,9 @@ void EnvironmentsBuilder::visitAttributeList(ast::AttributeList* attributeList)
 }
 
 void EnvironmentsBuilder::visitSingleMember(ast::SingleMember* member) {
-  auto& memberName = member->getId()->getNameAsStr();
   auto& typeName = member->getIdType()->getNameAsStr();
   auto* memberType = typeBuilder->getType(typeName);
-  currClassAttributes.members.insert({memberName, memberType});
+  currClassAttributes.members.insert({member->getId()->getNameId(), memberType});
 }
 
 void EnvironmentsBuilder::visitSingleMethod(ast::SingleMethod* method) {
@@ -42,7 +42,9 @@ void EnvironmentsBuilder::visitSingleMethod(ast::SingleMethod* method) {
 
   auto& methodName = method->getId()->getNameAsStr();
   auto* methodType = typeBuilder->getMethodType(methodName, returnType, currFormalParameters);
-  currClassAttributes.methods.insert({methodName, methodType});
+  if (currClassAttributes.methods.insert({method->getId()->getNameId(), methodType}).second) {
+    currClassAttributes.methodNodes.push_back(method);
+  }
 }
 
 void EnvironmentsBuilder::visitFormalList(ast::FormalList* formalList) {
@@ -53,7 +55,7 @@ void EnvironmentsBuilder::visitFormalList(ast::FormalList* formalList) {
   }
 }
 
-void EnvironmentsBuilder::inflateClassEnv(std::list<ast::CoolClass*>& coolClasses) {
+void EnvironmentsBuilder::inflateClassEnv(ast::NodeList<ast::CoolClass*>& coolClasses) {
   const auto& graph = context.getInheritanceGraph();
   for (auto* coolClass : coolClasses) {
     auto& className = coolClass->getCoolType()->getNameAsStr();
@@ -63,46 +65,69 @@ void EnvironmentsBuilder::inflateClassEnv(std::list<ast::CoolClass*>& coolClasse
     type::findInheritanceNodes(&node, nodes);
 
     auto* env = typeEnvironment.createClassEnvironment(className);
-    env->setInheritanceChain(nodes);
+    resolveMethods(&node);
 
+    auto& strings = context.getMemoryManager().getStrings();
     auto& memberSymTable = env->getMembers();
     for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
       auto& nodeName = (*it)->getNodeName();
       auto& classAttributes = classAttributesTable[nodeName];
 
-      for (auto& [memberName, memberType] : classAttributes.members) {
-        if (memberSymTable.lookup(memberName)) {
+      for (auto& [memberId, memberType] : classAttributes.members) {
+        if (memberSymTable.lookup(memberId)) {
           std::stringstream errStream;
-          errStream << "redefinition of member `" << memberName << "` in class `" << className
-                    << " at ` (see parent classes as well)";
+          errStream << "redefinition of member `" << strings.get(memberId)->get()
+                    << "` in class `" << className << " at ` (see parent classes as well)";
           errList.push_back(errStream.str());
         } else {
-          memberSymTable.add(memberName, memberType);
+          memberSymTable.add(memberId, memberType);
         }
       }
     }
 
     auto& methodSymTable = env->getMethods();
     auto& classAttributes = classAttributesTable[className];
-    for (auto& [methodName, methodType] : classAttributes.methods) {
+    for (auto& [methodId, methodType] : classAttributes.methods) {
       bool hasAlreadyBeenDefined{false};
-      if (auto currType = methodSymTable.lookup(methodName)) {
+      if (auto currType = methodSymTable.lookup(methodId)) {
         if (currType.value()->isSame(methodType)) {
           std::stringstream errStream;
-          errStream << "redefinition of method `" << methodName << "` in class `" << className
-                    << "` (see parent classes as well)";
+          errStream << "redefinition of method `" << strings.get(methodId)->get()
+                    << "` in class `" << className << "` (see parent classes as well)";
           errList.push_back(errStream.str());
           hasAlreadyBeenDefined = true;
         }
       }
       if (!hasAlreadyBeenDefined) {
-        methodSymTable.add(methodName, methodType);
+        methodSymTable.add(methodId, methodType);
       }
     }
 
-    auto selfName = std::string("self");
     auto* selfType = typeBuilder->getType(className);
-    memberSymTable.add(selfName, selfType);
+    memberSymTable.add(context.getMemoryManager().getSymbolId("self"), selfType);
+  }
+}
+
+// tables of parents are resolved first; a table is never changed once resolved, thus
+// `ResolvedMethod::overridden` pointers into it stay valid
+const type::ResolvedMethodTable& EnvironmentsBuilder::resolveMethods(type::Graph::Node* node) {
+  auto& resolvedMethods = context.getResolvedMethods();
+  auto& className = node->getNodeName();
+  auto it = resolvedMethods.find(className);
+  if (it != resolvedMethods.end()) {
+    return it->second;
+  }
+
+  type::ResolvedMethodTable table{};
+  if (auto* parent = node->getParent()) {
+    table.inherit(&resolveMethods(parent));
+  }
+
+  auto& classAttributes = classAttributesTable[className];
+  for (auto* method : classAttributes.methodNodes) {
+    auto* methodType = classAttributes.methods[method->getId()->getNameId()];
+    table.define(node->getCoolClass(), method, methodType);
   }
+  return resolvedMethods.insert({className, std::move(table)}).first->second;
 }
-} // namespace mcool::semant
\ No newline at end of file
+} // namespace mcool::semant
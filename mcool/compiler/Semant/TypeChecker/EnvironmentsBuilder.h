@@ -16,20 +16,23 @@ class EnvironmentsBuilder : public ast::Visitor, public Error {
   type::TypeEnvironments build(ast::CoolClassList* coolClassList);
 
   private:
-  void collectMethodAndAttrs(std::list<ast::CoolClass*>& coolClasses);
+  void collectMethodAndAttrs(ast::NodeList<ast::CoolClass*>& coolClasses);
   void visitAttributeList(ast::AttributeList* attributeList) override;
   void visitSingleMember(ast::SingleMember* member) override;
   void visitSingleMethod(ast::SingleMethod* method) override;
   void visitFormalList(ast::FormalList* formalList) override;
 
-  void inflateClassEnv(std::list<ast::CoolClass*>& coolClasses);
+  void inflateClassEnv(ast::NodeList<ast::CoolClass*>& coolClasses);
+  const type::ResolvedMethodTable& resolveMethods(type::Graph::Node* node);
 
   std::vector<type::Type*> currFormalParameters{};
   type::TypeEnvironments typeEnvironment{};
 
   struct ClassAttributes {
-    std::unordered_map<std::string, type::Type*> members{};
-    std::unordered_map<std::string, type::MethodType*> methods{};
+    std::unordered_map<SymbolId, type::Type*> members{};
+    std::unordered_map<SymbolId, type::MethodType*> methods{};
+    // the first definitions of methods in the order of declaration
+    std::vector<ast::SingleMethod*> methodNodes{};
   };
 
   ClassAttributes currClassAttributes{};
@@ -7,7 +7,8 @@ mcool::semant::InheritanceGraphBuilder::InheritanceGraphBuilder() {
   graph = std::make_unique<type::Graph>();
 }
 
-void mcool::semant::InheritanceGraphBuilder::initGraph(const std::list<ast::CoolClass*>& classes) {
+void mcool::semant::InheritanceGraphBuilder::initGraph(
+    const ast::NodeList<ast::CoolClass*>& classes) {
   for (auto& coolClass : classes) {
     auto& className{coolClass->getCoolType()->getNameAsStr()};
 
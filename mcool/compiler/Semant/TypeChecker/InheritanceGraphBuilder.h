@@ -20,12 +20,15 @@ class InheritanceGraphBuilder : public ast::Visitor, public semant::Error {
     assignParentNodes();
     assignChildNodes();
     checkInheritanceGraphCycles();
+    if (not hasErrors()) {
+      graph->buildIndex();
+    }
 
     return std::move(graph);
   }
 
   private:
-  void initGraph(const std::list<ast::CoolClass*>& classes);
+  void initGraph(const ast::NodeList<ast::CoolClass*>& classes);
   void checkParentClassDefinitions();
   void assignParentNodes();
   void assignChildNodes();
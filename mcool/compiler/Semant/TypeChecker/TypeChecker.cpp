@@ -1,4 +1,6 @@
 #include "Semant/TypeChecker/TypeChecker.h"
+#include "llvm/Support/Casting.h"
+#include <algorithm>
 #include <sstream>
 #include <unordered_set>
 
@@ -48,24 +50,21 @@ void TypeChecker::visitSingleMember(ast::SingleMember* member) {
   auto& memberName = member->getId()->getNameAsStr();
   auto& members = currClassEnv->getMembers();
 
-  auto declType = members.lookup(memberName);
+  auto declType = members.lookup(member->getId()->getNameId());
   assert(declType.has_value());
 
-  if (declType.value()->getAsString() == "SELF_TYPE") {
+  if (declType.value()->getTypeKind() == type::TypeKind::SelfType) {
     declType = selfType;
   }
   member->getId()->setSemantType(declType.value());
   member->setSemantType(declType.value());
 
   auto* initExpr = member->getInitExpr();
-  if (dynamic_cast<ast::NoExpr*>(initExpr) == nullptr) {
+  if (not llvm::isa<ast::NoExpr>(initExpr)) {
     initExpr->accept(this);
     auto* derivedType = initExpr->getSemantType();
 
-    auto declTypeNode = graph->getInheritanceNode(declType.value()->getAsString());
-    auto derivedTypeNode = graph->getInheritanceNode(derivedType->getAsString());
-
-    if (not derivedTypeNode.isChildOf(&declTypeNode)) {
+    if (not conformsTo(derivedType, declType.value())) {
       std::stringstream errStream;
       errStream << "type `" << derivedType->getAsString() << "` does not conform to type `"
                 << declType.value()->getAsString() << "` of a member `" << memberName
@@ -94,10 +93,7 @@ void TypeChecker::visitSingleMethod(ast::SingleMethod* method) {
     auto* returnBodyType = method->getBody()->getSemantType();
     assert(returnBodyType != nullptr);
 
-    auto returnDeclNode = graph->getInheritanceNode(returnDeclType->getAsString());
-    auto returnBodyNode = graph->getInheritanceNode(returnBodyType->getAsString());
-
-    if (returnBodyNode.isChildOf(&returnDeclNode)) {
+    if (conformsTo(returnBodyType, returnDeclType)) {
       std::vector<type::Type*> parameterList{};
       auto& formals = method->getParameters()->getFormals();
       std::for_each(formals.begin(), formals.end(), [&parameterList](ast::SingleFormal* formal) {
@@ -118,20 +114,18 @@ void TypeChecker::visitSingleMethod(ast::SingleMethod* method) {
 }
 
 void TypeChecker::visitFormalList(ast::FormalList* formalList) {
-  auto formals = formalList->getFormals();
+  auto& formals = formalList->getFormals();
   for (auto* formal : formals) {
     formal->accept(this);
   }
 }
 
 void TypeChecker::visitSingleFormal(ast::SingleFormal* formal) {
-  auto& formalName = formal->getId()->getNameAsStr();
-
   auto& members = currClassEnv->getMembers();
   auto& formalTypeName = formal->getIdType()->getNameAsStr();
   auto* fortmalType = typeBuilder->getType(formalTypeName);
   formal->setSemantType(fortmalType);
-  members.add(formalName, fortmalType);
+  members.add(formal->getId()->getNameId(), fortmalType);
 
   formal->setSemantType(typeBuilder->getType(formalTypeName));
 }
@@ -185,25 +179,19 @@ void TypeChecker::visitPrimaryExpr(ast::PrimaryExpr* node) {
 
 void TypeChecker::visitDispatch(ast::Dispatch* dispatch) {
   auto& methodName = dispatch->getMethodId()->getNameAsStr();
+  auto methodId = dispatch->getMethodId()->getNameId();
 
   dispatch->getObjectId()->accept(this);
   auto* objectIdType = dispatch->getObjectId()->getSemantType();
-  if (objectIdType->getAsString() == "SELF_TYPE") {
+  if (objectIdType->getTypeKind() == type::TypeKind::SelfType) {
     objectIdType = selfType;
   }
 
   std::vector<type::MethodType*> foundMethodTypes{};
-  if (auto exprEnv = environments.getClass(objectIdType->getAsString())) {
-    auto& inheritanceChain = exprEnv.value()->getInheritanceChain();
-    for (auto* classNode : inheritanceChain) {
-      auto env = environments.getClass(classNode->getNodeName());
-      assert(env.has_value());
-      auto& currMethodTable = env.value()->getMethods();
-      if (auto methodType = currMethodTable.lookup(methodName)) {
-        if (methodType.has_value()) {
-          foundMethodTypes.push_back(methodType.value());
-        }
-      }
+  if (auto* methodTable = getResolvedMethods(objectIdType)) {
+    for (auto* resolved = methodTable->find(methodId); resolved != nullptr;
+         resolved = resolved->overridden) {
+      foundMethodTypes.push_back(resolved->type);
     }
   } else {
     std::stringstream errStream;
@@ -244,7 +232,7 @@ void TypeChecker::visitDispatch(ast::Dispatch* dispatch) {
   }
 
   auto* methodReturnType = methodType->getReturnType();
-  if (methodReturnType->getAsString() == std::string("SELF_TYPE")) {
+  if (methodReturnType->getTypeKind() == type::TypeKind::SelfType) {
     methodReturnType = objectIdType;
   }
 
@@ -253,6 +241,7 @@ void TypeChecker::visitDispatch(ast::Dispatch* dispatch) {
 
 void TypeChecker::visitStaticDispatch(ast::StaticDispatch* dispatch) {
   auto& methodName = dispatch->getMethodId()->getNameAsStr();
+  auto methodId = dispatch->getMethodId()->getNameId();
 
   dispatch->getObjectId()->accept(this);
   auto& castTypeName = dispatch->getCastType()->getNameAsStr();
@@ -270,17 +259,10 @@ void TypeChecker::visitStaticDispatch(ast::StaticDispatch* dispatch) {
   }
 
   std::vector<type::MethodType*> foundMethodTypes{};
-  if (auto exprEnv = environments.getClass(castTypeName)) {
-    auto& inheritanceChain = exprEnv.value()->getInheritanceChain();
-    for (auto* classNode : inheritanceChain) {
-      auto env = environments.getClass(classNode->getNodeName());
-      assert(env.has_value());
-      auto& currMethodTable = env.value()->getMethods();
-      if (auto methodType = currMethodTable.lookup(methodName)) {
-        if (methodType.has_value()) {
-          foundMethodTypes.push_back(methodType.value());
-        }
-      }
+  if (auto* methodTable = getResolvedMethods(typeBuilder->getType(castTypeName))) {
+    for (auto* resolved = methodTable->find(methodId); resolved != nullptr;
+         resolved = resolved->overridden) {
+      foundMethodTypes.push_back(resolved->type);
     }
   } else {
     std::stringstream errStream;
@@ -321,7 +303,7 @@ void TypeChecker::visitStaticDispatch(ast::StaticDispatch* dispatch) {
   }
 
   auto* methodReturnType = methodType->getReturnType();
-  if (methodReturnType->getAsString() == std::string("SELF_TYPE")) {
+  if (methodReturnType->getTypeKind() == type::TypeKind::SelfType) {
     methodReturnType = objectIdType;
   }
 
@@ -345,11 +327,7 @@ void TypeChecker::visitCaseExpr(ast::CaseExpr* caseExpr) {
 
   auto* commonType = casesTypes[0];
   for (size_t i = 1; i < casses.size(); ++i) {
-    const auto& node1 = graph->getInheritanceNode(commonType->getAsString());
-    const auto& node2 = graph->getInheritanceNode(casesTypes[i]->getAsString());
-
-    auto* commonNode = type::findCommonParentType(&node1, &node2);
-    commonType = typeBuilder->getType(commonNode->getNodeName());
+    commonType = join(commonType, casesTypes[i]);
   }
   caseExpr->setSemantType(commonType);
 }
@@ -362,13 +340,12 @@ void TypeChecker::visitCaseList(ast::CaseList* caseList) {
 }
 
 void TypeChecker::visitSingleCase(ast::SingleCase* aCase) {
-  auto& bindVarName = aCase->getId()->getNameAsStr();
   auto& bindVarTypeName = aCase->getIdType()->getNameAsStr();
   auto* bindType = typeBuilder->getType(bindVarTypeName);
 
   auto& members = currClassEnv->getMembers();
   members.pushScope();
-  members.add(bindVarName, bindType);
+  members.add(aCase->getId()->getNameId(), bindType);
 
   aCase->getBody()->accept(this);
   auto* bodyType = aCase->getBody()->getSemantType();
@@ -416,11 +393,7 @@ void TypeChecker::visitIfThenElseExpr(ast::IfThenElseExpr* condExpr) {
   auto* elseBodyType = condExpr->getElseBody()->getSemantType();
   assert(elseBodyType != nullptr);
 
-  const auto& thenNode = graph->getInheritanceNode(thenBodyType->getAsString());
-  const auto& elseNode = graph->getInheritanceNode(elseBodyType->getAsString());
-
-  auto* commonNode = type::findCommonParentType(&thenNode, &elseNode);
-  auto* commonType = typeBuilder->getType(commonNode->getNodeName());
+  auto* commonType = join(thenBodyType, elseBodyType);
   assert(commonType != nullptr);
   condExpr->setSemantType(commonType);
 }
@@ -444,14 +417,11 @@ void TypeChecker::visitLetExpr(ast::LetExpr* letExpr) {
   auto* initExprType = initExpr->getSemantType();
   assert(initExprType != nullptr);
 
-  if (dynamic_cast<ast::NoExpr*>(initExpr) != nullptr) {
+  if (llvm::isa<ast::NoExpr>(initExpr)) {
     initExprType = idType;
   }
 
-  const auto& idNode = graph->getInheritanceNode(idType->getAsString());
-  const auto& initExprNode = graph->getInheritanceNode(initExprType->getAsString());
-
-  if (not initExprNode.isChildOf(&idNode)) {
+  if (not conformsTo(initExprType, idType)) {
     std::stringstream errStream;
     errStream << "type `" << initExprType->getAsString() << "` does not conform to type `"
               << idType->getAsString() << "` of identifier `" << idName << "`. See at "
@@ -462,7 +432,7 @@ void TypeChecker::visitLetExpr(ast::LetExpr* letExpr) {
 
   auto& members = currClassEnv->getMembers();
   members.pushScope();
-  members.add(idName, idType);
+  members.add(letExpr->getId()->getNameId(), idType);
 
   letExpr->getBody()->accept(this);
   auto* bodyExprType = letExpr->getBody()->getSemantType();
@@ -473,17 +443,14 @@ void TypeChecker::visitLetExpr(ast::LetExpr* letExpr) {
 }
 
 void TypeChecker::visitAssignExpr(ast::AssignExpr* node) {
-  auto idName = node->getId()->getNameAsStr();
+  auto& idName = node->getId()->getNameAsStr();
 
-  auto members = currClassEnv->getMembers();
-  if (auto idType = members.lookup(idName)) {
+  auto& members = currClassEnv->getMembers();
+  if (auto idType = members.lookup(node->getId()->getNameId())) {
     node->getInitExpr()->accept(this);
     auto* initExprType = node->getInitExpr()->getSemantType();
 
-    auto idGraphNode = graph->getInheritanceNode(idType.value()->getAsString());
-    auto initGraphNode = graph->getInheritanceNode(initExprType->getAsString());
-
-    if (initGraphNode.isChildOf(&idGraphNode)) {
+    if (conformsTo(initExprType, idType.value())) {
       node->setSemantType(idType.value());
     } else {
       std::stringstream errStream;
@@ -606,7 +573,7 @@ type::Type* TypeChecker::getBinaryExprType(ast::BinaryExpression* binaryExpr) {
   assert(rightOperandType != nullptr);
 
   if (leftOperandType->isSame(rightOperandType)) {
-    return typeBuilder->getType(leftOperandType->getAsString());
+    return leftOperandType;
   } else {
     mcool::Loc loc(binaryExpr->getLeft()->getLocation(), binaryExpr->getRight()->getLocation());
     std::stringstream errStream;
@@ -637,7 +604,7 @@ void TypeChecker::visitNoExpr(ast::NoExpr* noExpr) {
 void TypeChecker::visitObjectId(ast::ObjectId* id) {
   auto& idName = id->getNameAsStr();
   auto& members = currClassEnv->getMembers();
-  if (auto idType = members.lookup(idName)) {
+  if (auto idType = members.lookup(id->getNameId())) {
     id->setSemantType(idType.value());
   } else {
     std::stringstream errStream;
@@ -675,7 +642,7 @@ bool TypeChecker::doesTypeExist(const std::string& typeName, Loc& loc) {
   }
 }
 
-bool TypeChecker::isAllMethodArgsOk(type::MethodType* methodType, std::list<ast::Node*>& args) {
+bool TypeChecker::isAllMethodArgsOk(type::MethodType* methodType, ast::NodeList<ast::Node*>& args) {
   auto& paramTypes = methodType->getParameters();
   if (paramTypes.size() != args.size()) {
     return false;
@@ -683,15 +650,54 @@ bool TypeChecker::isAllMethodArgsOk(type::MethodType* methodType, std::list<ast:
 
   auto argsIt = args.begin();
   for (size_t i = 0; i < paramTypes.size(); ++i, ++argsIt) {
-    const auto& paramNode = graph->getInheritanceNode(paramTypes[i]->getAsString());
     auto* argType = (*argsIt)->getSemantType();
-    const auto& argNode = graph->getInheritanceNode(argType->getAsString());
-
-    if (!argNode.isChildOf(&paramNode)) {
+    if (not conformsTo(argType, paramTypes[i])) {
       return false;
     }
   }
 
   return true;
 }
-} // namespace mcool::semant
\ No newline at end of file
+
+// graph nodes are looked up by name once per type and then by the type id
+const type::Graph::Node& TypeChecker::getGraphNode(type::Type* type) {
+  auto id = type->getId();
+  if (id >= graphNodes.size()) {
+    graphNodes.resize(typeBuilder->getNumTypes(), nullptr);
+  }
+  if (graphNodes[id] == nullptr) {
+    graphNodes[id] = &graph->getInheritanceNode(type->getAsString());
+  }
+  return *graphNodes[id];
+}
+
+bool TypeChecker::conformsTo(type::Type* derived, type::Type* base) {
+  return getGraphNode(derived).isChildOf(&getGraphNode(base));
+}
+
+type::Type* TypeChecker::join(type::Type* first, type::Type* second) {
+  if (first == second) {
+    return first;
+  }
+  auto* commonNode = type::findCommonParentType(&getGraphNode(first), &getGraphNode(second));
+  auto* commonType = typeBuilder->getType(commonNode->getNodeName());
+  assert(commonType != nullptr);
+  return commonType;
+}
+
+const type::ResolvedMethodTable* TypeChecker::getResolvedMethods(type::Type* type) {
+  auto id = type->getId();
+  if (id >= methodTables.size()) {
+    methodTables.resize(typeBuilder->getNumTypes(), nullptr);
+  }
+  if (methodTables[id] == nullptr) {
+    auto& resolvedMethods = context.getResolvedMethods();
+    auto it = resolvedMethods.find(type->getAsString());
+    if (it == resolvedMethods.end()) {
+      return nullptr;
+    }
+    methodTables[id] = &it->second;
+  }
+  return methodTables[id];
+}
+} // namespace mcool::semant
@@ -58,7 +58,11 @@ class TypeChecker : public ast::Visitor, public Error {
   type::Type* getBinaryExprType(ast::BinaryExpression* binaryExpr);
   type::Type* getLogicalExprType(ast::BinaryExpression* binaryExpr);
   bool doesTypeExist(const std::string& typeName, Loc& loc);
-  bool isAllMethodArgsOk(type::MethodType* methodType, std::list<ast::Node*>& argsTypes);
+  bool isAllMethodArgsOk(type::MethodType* methodType, ast::NodeList<ast::Node*>& argsTypes);
+  const type::Graph::Node& getGraphNode(type::Type* type);
+  bool conformsTo(type::Type* derived, type::Type* base);
+  type::Type* join(type::Type* first, type::Type* second);
+  const type::ResolvedMethodTable* getResolvedMethods(type::Type* type);
 
   Context& context;
   std::unique_ptr<type::TypeBuilder>& typeBuilder;
@@ -70,5 +74,7 @@ class TypeChecker : public ast::Visitor, public Error {
 
   type::Type* selfType{nullptr};
   type::Type* errorType{nullptr};
+  std::vector<const type::Graph::Node*> graphNodes{};
+  std::vector<const type::ResolvedMethodTable*> methodTables{};
 };
 } // namespace mcool::semant
\ No newline at end of file
@@ -3,12 +3,17 @@
 #include "Semant/TypeChecker/EnvironmentsBuilder.h"
 #include "Semant/TypeChecker/TypeChecker.h"
 #include "Semant/EntryPointChecker.h"
+#include "PhaseTimer.h"
 #include <iostream>
 #include <sstream>
 
 bool mcool::TypeDriver::run(mcool::AstTree& classes) {
   semant::InheritanceGraphBuilder graphBuilder{};
-  auto graph = graphBuilder.build(classes.get());
+  std::unique_ptr<type::Graph> graph{};
+  {
+    misc::ScopedPhase phase("Inheritance graph");
+    graph = graphBuilder.build(classes.get());
+  }
   if (graphBuilder.hasErrors()) {
     errorLogger.retrieveErrors(&graphBuilder);
     return false;
@@ -20,21 +25,31 @@ bool mcool::TypeDriver::run(mcool::AstTree& classes) {
 
   context.setInheritanceGraph(std::move(graph));
   semant::EnvironmentsBuilder envBuilder(context);
-  auto env = envBuilder.build(classes.get());
+  type::TypeEnvironments env{};
+  {
+    misc::ScopedPhase phase("Environments");
+    env = envBuilder.build(classes.get());
+  }
   if (envBuilder.hasErrors()) {
     errorLogger.retrieveErrors(&envBuilder);
     return false;
   }
 
   semant::TypeChecker typeChecker(context, env);
-  typeChecker.run(classes.get());
+  {
+    misc::ScopedPhase phase("Type checker");
+    typeChecker.run(classes.get());
+  }
   if (typeChecker.hasErrors()) {
     errorLogger.retrieveErrors(&typeChecker);
     return false;
   }
 
   semant::EntryPointChecker entryPointChecker{};
-  entryPointChecker.run(classes.get());
+  {
+    misc::ScopedPhase phase("Entry point checker");
+    entryPointChecker.run(classes.get());
+  }
   if (entryPointChecker.hasErrors()) {
     errorLogger.retrieveErrors(&entryPointChecker);
     return false;
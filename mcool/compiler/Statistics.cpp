@@ -0,0 +1,95 @@
+#include "Statistics.h"
+#include "MemoryManager.h"
+#include "Parser/AstTree.h"
+#include "llvm/Support/Casting.h"
+#include <algorithm>
+#include <iomanip>
+#include <sys/resource.h>
+
+namespace mcool::misc {
+void Statistics::add(const std::string& group, const std::string& name, uint64_t value) {
+  auto it = std::find_if(
+      groups.begin(), groups.end(), [&group](auto& item) { return item.first == group; });
+  if (it == groups.end()) {
+    it = groups.insert(groups.end(), {group, Counters{}});
+  }
+  it->second.emplace_back(name, value);
+}
+
+// builtin classes are counted as well
+void Statistics::addProgram(AstTree& astTree) {
+  uint64_t numClasses{0};
+  uint64_t numMethods{0};
+  uint64_t numMembers{0};
+  for (auto* coolClass : astTree.get()->getData()) {
+    ++numClasses;
+    for (auto* attr : coolClass->getAttributes()->getData()) {
+      if (llvm::isa<ast::SingleMethod>(attr)) {
+        ++numMethods;
+      } else {
+        ++numMembers;
+      }
+    }
+  }
+  add("program", "classes", numClasses);
+  add("program", "methods", numMethods);
+  add("program", "members", numMembers);
+}
+
+void Statistics::addMemory(const MemoryManager& memoryManager) {
+  for (auto& [className, count] : memoryManager.getNodeCounts()) {
+    add("ast nodes", className, count);
+  }
+  add("memory", "ast node bytes", memoryManager.getNodeBytes());
+  add("memory", "arena bytes", memoryManager.getArenaBytes());
+  add("memory", "arena slabs", memoryManager.getNumArenaSlabs());
+
+  auto tableSizes = memoryManager.getStringTableSizes();
+  add("interned strings", "static", tableSizes.staticStrings);
+  add("interned strings", "object", tableSizes.objectStrings);
+  add("interned strings", "raw", tableSizes.rawStrings);
+  add("interned strings", "symbols", memoryManager.getStrings().size());
+}
+
+void Statistics::addResourceUsage() {
+  struct rusage usage {};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    // kilobytes on linux
+    add("memory", "peak rss bytes", static_cast<uint64_t>(usage.ru_maxrss) * 1024);
+  }
+}
+
+void Statistics::print(std::ostream& stream, bool asJson) {
+  if (asJson) {
+    printJson(stream);
+  } else {
+    printText(stream);
+  }
+}
+
+void Statistics::printText(std::ostream& stream) {
+  stream << "===== compiler statistics =====\n";
+  for (auto& [group, counters] : groups) {
+    stream << group << ":\n";
+    for (auto& [name, value] : counters) {
+      stream << "  " << std::left << std::setw(32) << name << std::right << std::setw(12)
+             << value << '\n';
+    }
+  }
+}
+
+// names are plain identifiers and class names, thus they need no escaping
+void Statistics::printJson(std::ostream& stream) {
+  stream << "{";
+  for (size_t i = 0; i < groups.size(); ++i) {
+    auto& [group, counters] = groups[i];
+    stream << (i ? ",\n " : "\n ") << '"' << group << "\": {";
+    for (size_t j = 0; j < counters.size(); ++j) {
+      auto& [name, value] = counters[j];
+      stream << (j ? ", " : "") << '"' << name << "\": " << value;
+    }
+    stream << "}";
+  }
+  stream << "\n}\n";
+}
+} // namespace mcool::misc
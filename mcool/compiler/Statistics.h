@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mcool {
+class AstTree;
+class MemoryManager;
+} // namespace mcool
+
+namespace mcool::misc {
+// Sizes of the compiler's own data structures and of the generated code, see `--stats`.
+// Counters are grouped and printed in the order they were added.
+class Statistics {
+  public:
+  void add(const std::string& group, const std::string& name, uint64_t value);
+  void addProgram(AstTree& astTree);
+  void addMemory(const MemoryManager& memoryManager);
+  void addResourceUsage();
+
+  void print(std::ostream& stream, bool asJson);
+
+  private:
+  using Counters = std::vector<std::pair<std::string, uint64_t>>;
+  void printText(std::ostream& stream);
+  void printJson(std::ostream& stream);
+
+  std::vector<std::pair<std::string, Counters>> groups{};
+};
+} // namespace mcool::misc
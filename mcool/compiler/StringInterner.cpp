@@ -0,0 +1,61 @@
+#include "StringInterner.h"
+#include <functional>
+#include <string>
+
+namespace mcool {
+ast::StringPtr* StringInterner::intern(std::string_view str) {
+  // keeps the load factor below 3/4
+  if (4 * (symbols.size() + 1) > 3 * slots.size()) {
+    grow();
+  }
+
+  auto hash = std::hash<std::string_view>{}(str);
+  auto slot = findSlot(str, hash);
+  if (slots[slot] != 0) {
+    return symbols[slots[slot] - 1].ptr;
+  }
+
+  auto id = static_cast<SymbolId>(symbols.size());
+  auto* ptr = arena.create<ast::StringPtr>(std::string(str), id);
+  symbols.push_back({ptr, hash});
+  slots[slot] = id + 1;
+  return ptr;
+}
+
+ast::StringPtr* StringInterner::find(std::string_view str) const {
+  if (slots.empty()) {
+    return nullptr;
+  }
+  auto slot = findSlot(str, std::hash<std::string_view>{}(str));
+  return (slots[slot] != 0) ? symbols[slots[slot] - 1].ptr : nullptr;
+}
+
+// returns either the slot of `str` or the free slot where it belongs
+size_t StringInterner::findSlot(std::string_view str, size_t hash) const {
+  auto mask = slots.size() - 1;
+  for (auto slot = hash & mask;; slot = (slot + 1) & mask) {
+    auto entry = slots[slot];
+    if (entry == 0) {
+      return slot;
+    }
+    auto& symbol = symbols[entry - 1];
+    if ((symbol.hash == hash) && (symbol.ptr->get() == str)) {
+      return slot;
+    }
+  }
+}
+
+// rehashing uses the stored hashes; strings are not hashed again
+void StringInterner::grow() {
+  std::vector<SymbolId> newSlots(slots.empty() ? 64 : 2 * slots.size(), 0);
+  auto mask = newSlots.size() - 1;
+  for (SymbolId id = 0; id < symbols.size(); ++id) {
+    auto slot = symbols[id].hash & mask;
+    while (newSlots[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    newSlots[slot] = id + 1;
+  }
+  slots = std::move(newSlots);
+}
+} // namespace mcool
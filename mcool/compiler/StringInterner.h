@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Arena.h"
+#include "ast.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace mcool {
+using SymbolId = uint32_t;
+
+// Maps equal strings to a single `ast::StringPtr`. Strings are numbered densely in the order
+// of interning, thus their ids can index vectors instead of hashing strings again.
+// Only the `StringPtr` objects live in the arena. They keep a `std::string`, because the
+// generated `get<Attribute>AsStr()` getters hand out `std::string&` to the whole compiler;
+// strings longer than the small-string buffer therefore still allocate their bytes on the
+// heap, once per distinct string.
+class StringInterner {
+  public:
+  StringInterner() = default;
+  StringInterner(StringInterner&& other) = default;
+
+  ast::StringPtr* intern(std::string_view str);
+  ast::StringPtr* find(std::string_view str) const;
+  ast::StringPtr* get(SymbolId id) const { return symbols[id].ptr; }
+  size_t size() const { return symbols.size(); }
+
+  private:
+  struct Symbol {
+    ast::StringPtr* ptr;
+    size_t hash;
+  };
+
+  size_t findSlot(std::string_view str, size_t hash) const;
+  void grow();
+
+  std::vector<Symbol> symbols{};
+  // open addressing with linear probing; a slot holds an id plus one, zero marks a free slot
+  std::vector<SymbolId> slots{};
+  Arena arena{};
+};
+} // namespace mcool
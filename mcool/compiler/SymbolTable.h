@@ -1,77 +1,108 @@
 #pragma once
 
-#include "OrderedDict.h"
-#include <list>
+#include "StringInterner.h"
+#include <limits>
 #include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <cassert>
 
 namespace mcool::type {
-template <typename Key, typename Value>
+// Scoped table of interned symbols. Bindings of all scopes are kept in a single log in the
+// order of definition, and every symbol maps to its innermost binding, which links to the
+// binding it shadows. Thus a lookup takes a single hash of an integer, and popping a scope
+// undoes only the bindings of that scope.
+template <typename Value>
 class SymbolTable {
-  using ScopeType = mcool::OrderedDict<Key, Value>;
-
   public:
-  SymbolTable() { scopes.push_back(ScopeType()); }
-
-  void pushScope() { scopes.push_back(ScopeType()); }
-  void popScope() {
-    assert(not scopes.empty());
-    scopes.pop_back();
-  }
+  struct Binding {
+    SymbolId key;
+    Value value;
+    size_t shadowed;
+  };
 
-  ScopeType& getTopScope() { return scopes.back(); }
-  auto getNumScopes() { return scopes.size(); }
+  // bindings of a single scope in the order of definition
+  class Scope {
+    public:
+    Scope(Binding* first, Binding* last) : first(first), last(last) {}
+    Binding* begin() const { return first; }
+    Binding* end() const { return last; }
+    size_t size() const { return last - first; }
 
-  std::optional<Value> lookup(const Key& key) {
-    for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
-      if (auto* value = scope->find(key)) {
-        return *value;
-      }
-    }
-    return std::optional<Value>{};
+    private:
+    Binding* first;
+    Binding* last;
   };
 
-  Value& operator[](Key& key) {
-    for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
-      if (scope->contains(key)) {
-        return (*scope)[key];
+  SymbolTable() { scopeStarts.push_back(0); }
+
+  void pushScope() { scopeStarts.push_back(bindings.size()); }
+  void popScope() {
+    assert(not scopeStarts.empty());
+    auto scopeStart = scopeStarts.back();
+    while (bindings.size() > scopeStart) {
+      auto& binding = bindings.back();
+      if (binding.shadowed == none) {
+        heads.erase(binding.key);
+      } else {
+        heads[binding.key] = binding.shadowed;
       }
+      bindings.pop_back();
     }
-    assert(true && "key have not found");
+    scopeStarts.pop_back();
   }
 
-  void add(Key& key, Value& value) {
-    auto& scope = scopes.back();
-    scope.insert(key, value);
+  Scope getTopScope() { return getScope(scopeStarts.size() - 1); }
+  std::vector<Scope> getScopes() {
+    std::vector<Scope> scopes{};
+    for (size_t level = 0; level < scopeStarts.size(); ++level) {
+      scopes.push_back(getScope(level));
+    }
+    return scopes;
   }
+  auto getNumScopes() const { return scopeStarts.size(); }
 
-  void add(const Key& key, Value& value) {
-    auto& scope = scopes.back();
-    scope.insert(key, value);
+  Value* find(SymbolId key) {
+    auto it = heads.find(key);
+    return (it != heads.end()) ? &(bindings[it->second].value) : nullptr;
   }
 
-  std::optional<Value> print(std::ostream& stream) {
-    size_t level{0};
-    for (auto scope = scopes.begin(); scope != scopes.end(); ++scope, ++level) {
-      stream << "level: " << level << '\n';
-      auto keys = scope->keys();
-      for (auto key : keys) {
-        if (std::is_same_v<Key, std::string>) {
-          stream << "key: " << key;
-        }
-        if (std::is_same_v<Value, Type*> || std::is_same_v<Value, MethodType*>) {
-          auto* value = (*scope)[key];
-          stream << "; value: " << value->getAsString();
-        }
-        stream << '\n';
-      }
+  std::optional<Value> lookup(SymbolId key) {
+    if (auto* value = find(key)) {
+      return *value;
     }
+    return std::optional<Value>{};
+  }
+
+  Value& operator[](SymbolId key) {
+    auto* value = find(key);
+    assert((value != nullptr) && "symbol is not defined");
+    return *value;
   }
 
-  auto begin() { return scopes.begin(); }
-  auto end() { return scopes.end(); }
+  void add(SymbolId key, Value value) {
+    assert(not scopeStarts.empty());
+    auto it = heads.find(key);
+    auto shadowed = (it != heads.end()) ? it->second : none;
+    assert(((shadowed == none) || (shadowed < scopeStarts.back())) &&
+           "symbol is already defined in the scope");
+
+    bindings.push_back(Binding{key, std::move(value), shadowed});
+    heads[key] = bindings.size() - 1;
+  }
 
   private:
-  std::list<ScopeType> scopes{};
+  static constexpr size_t none{std::numeric_limits<size_t>::max()};
+
+  Scope getScope(size_t level) {
+    auto first = scopeStarts[level];
+    auto last = (level + 1 < scopeStarts.size()) ? scopeStarts[level + 1] : bindings.size();
+    return Scope(bindings.data() + first, bindings.data() + last);
+  }
+
+  std::vector<Binding> bindings{};
+  std::vector<size_t> scopeStarts{};
+  std::unordered_map<SymbolId, size_t> heads{};
 };
-} // namespace mcool::type
\ No newline at end of file
+} // namespace mcool::type
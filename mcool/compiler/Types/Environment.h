@@ -14,23 +14,68 @@ class ClassEnvironment {
   public:
   ClassEnvironment(std::string userClassName) : className(userClassName) {}
 
-  using MembersTableType = SymbolTable<std::string, Type*>;
-  using MethodsTableType = SymbolTable<std::string, MethodType*>;
+  using MembersTableType = SymbolTable<Type*>;
+  using MethodsTableType = SymbolTable<MethodType*>;
 
   MembersTableType& getMembers() { return members; }
   MethodsTableType& getMethods() { return methods; }
 
   std::string getClassName() { return className; }
-  void setInheritanceChain(const std::vector<Graph::Node*>& chain) { inheritanceChain = chain; }
-  std::vector<Graph::Node*>& getInheritanceChain() { return inheritanceChain; }
 
   private:
   std::string className{};
   MembersTableType members{};
   MethodsTableType methods{};
-  std::vector<Graph::Node*> inheritanceChain{};
 };
 
+// the most derived definition of a method visible in a class
+struct ResolvedMethod {
+  SymbolId name{};
+  ast::CoolClass* owner{nullptr};
+  ast::SingleMethod* method{nullptr};
+  MethodType* type{nullptr};
+  // a definition of the same method in a parent class
+  const ResolvedMethod* overridden{nullptr};
+};
+
+// Methods of a class together with the inherited ones, in the order of their first definition
+// along the inheritance chain, i.e. in the order of dispatch table slots. A table of a class
+// starts as a copy of the table of its parent, thus a lookup never walks the chain.
+class ResolvedMethodTable {
+  public:
+  const ResolvedMethod* find(SymbolId name) const {
+    auto it = indices.find(name);
+    return (it != indices.end()) ? &methods[it->second] : nullptr;
+  }
+  const std::vector<ResolvedMethod>& getMethods() const { return methods; }
+
+  void define(ast::CoolClass* owner, ast::SingleMethod* method, MethodType* type) {
+    auto name = method->getId()->getNameId();
+    auto it = indices.find(name);
+    if (it == indices.end()) {
+      indices.insert({name, methods.size()});
+      methods.push_back(ResolvedMethod{name, owner, method, type, nullptr});
+    } else {
+      auto& resolved = methods[it->second];
+      auto* overridden = (parentMethods != nullptr) ? parentMethods->find(name) : nullptr;
+      resolved = ResolvedMethod{name, owner, method, type, overridden};
+    }
+  }
+
+  void inherit(const ResolvedMethodTable* parent) {
+    *this = *parent;
+    parentMethods = parent;
+  }
+
+  private:
+  std::vector<ResolvedMethod> methods{};
+  std::unordered_map<SymbolId, size_t> indices{};
+  const ResolvedMethodTable* parentMethods{nullptr};
+};
+
+// resolved methods of every class by class names
+using ResolvedMethods = std::unordered_map<std::string, ResolvedMethodTable>;
+
 class TypeEnvironments {
   public:
   ClassEnvironment* createClassEnvironment(const std::string& className) {
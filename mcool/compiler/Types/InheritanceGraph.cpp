@@ -17,6 +17,9 @@ Graph::Node::Node(std::string name) : nodeName(std::move(name)) {
 bool Graph::Node::isSame(Node* other) const { return this->id == other->id; }
 
 bool Graph::Node::isChildOf(const Node* other) const {
+  if (isIndexed && other->isIndexed) {
+    return (other->preorder <= preorder) && (postorder <= other->postorder);
+  }
   if (this->isSame(const_cast<Node*>(other))) {
     return true;
   } else {
@@ -32,7 +35,68 @@ const type::Graph::Node& Graph::getInheritanceNode(const std::string& name) {
   }
 }
 
+// numbers the nodes in depth-first order from the roots and fills jump pointers of
+// ancestors; the graph must not contain cycles
+void Graph::buildIndex() {
+  indexedNodes.clear();
+  std::vector<Node*> roots{};
+  for (auto& [name, node] : nodes) {
+    if (node.parent == nullptr) {
+      roots.push_back(&node);
+    }
+  }
+
+  size_t counter{0};
+  std::function<void(Node*, size_t)> visit = [&](Node* node, size_t depth) {
+    node->index = indexedNodes.size();
+    node->preorder = counter++;
+    node->depth = depth;
+    indexedNodes.push_back(node);
+
+    node->ancestors.clear();
+    for (auto* ancestor = node->parent; ancestor != nullptr;) {
+      node->ancestors.push_back(ancestor);
+      auto level = node->ancestors.size() - 1;
+      ancestor = (level < ancestor->ancestors.size()) ? ancestor->ancestors[level] : nullptr;
+    }
+
+    for (auto* child : node->children) {
+      visit(child, depth + 1);
+    }
+    node->postorder = counter++;
+    node->isIndexed = true;
+  };
+  for (auto* root : roots) {
+    visit(root, 0);
+  }
+}
+
 const Graph::Node* findCommonParentType(const Graph::Node* node1, const Graph::Node* node2) {
+  if (node1->hasIndex() && node2->hasIndex()) {
+    if (node1->getDepth() < node2->getDepth()) {
+      std::swap(node1, node2);
+    }
+    // lifts the deeper node to the depth of the other one
+    auto distance = node1->getDepth() - node2->getDepth();
+    for (size_t level = 0; distance != 0; ++level, distance >>= 1) {
+      if (distance & 1) {
+        node1 = node1->getAncestor(level);
+      }
+    }
+    if (node1 == node2) {
+      return node1;
+    }
+    // both nodes are at the same depth, thus they have the same number of ancestors
+    for (size_t level = node1->getNumAncestors(); level-- > 0;) {
+      if ((level < node1->getNumAncestors()) &&
+          (node1->getAncestor(level) != node2->getAncestor(level))) {
+        node1 = node1->getAncestor(level);
+        node2 = node2->getAncestor(level);
+      }
+    }
+    return node1->getParent();
+  }
+
   if (node1->isNodeName("Object")) {
     return node1;
   } else if (node2->isNodeName("Object")) {
@@ -23,6 +23,12 @@ public:
     void addChild(Node* node) { children.push_back(node); }
 
     auto getId() { return id; }
+    // dense index of the node, set by `Graph::buildIndex`
+    size_t getIndex() const { return index; }
+    size_t getDepth() const { return depth; }
+    bool hasIndex() const { return isIndexed; }
+    size_t getNumAncestors() const { return ancestors.size(); }
+    const Node* getAncestor(size_t level) const { return ancestors[level]; }
     const auto& getNodeName() const { return nodeName; }
     const auto* getParent() const { return parent; }
     auto* getParent() { return parent; }
@@ -34,11 +40,21 @@ public:
     }
 
 private:
+    friend class Graph;
     size_t id{};
     std::string nodeName{};
     Node* parent{nullptr};
     std::vector<Node*> children{};
     mcool::ast::CoolClass* classAstNode{nullptr};
+
+    // a node is a descendant of another one if its preorder interval lies inside the other
+    bool isIndexed{false};
+    size_t index{};
+    size_t preorder{};
+    size_t postorder{};
+    size_t depth{};
+    // `ancestors[k]` is the ancestor 2^k levels above
+    std::vector<Node*> ancestors{};
   };
 
   Graph() = default;
@@ -47,6 +63,8 @@ private:
   const type::Graph::Node& getInheritanceNode(const std::string& name);
   bool containsNode(const std::string& name) { return nodes.find(name) != nodes.end(); }
   size_t size() { return nodes.size(); }
+  void buildIndex();
+  const Node& getNode(size_t index) const { return *indexedNodes[index]; }
 
   auto begin() { return nodes.begin(); }
   auto cbegin() { return nodes.cbegin(); }
@@ -58,6 +76,7 @@ private:
 
   private:
   std::unordered_map<std::string, Node> nodes;
+  std::vector<Node*> indexedNodes{};
   size_t nodeCounter{0};
 };
 
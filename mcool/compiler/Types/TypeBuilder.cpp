@@ -1,75 +1,66 @@
 #include "Types/TypeBuilder.h"
+#include <functional>
 #include <cassert>
-#include <sstream>
 
 namespace mcool::type {
-TypeBuilder::~TypeBuilder() {
-  for (auto& type : types) {
-    delete type.second;
+TypeBuilder::TypeBuilder() {
+  for (Type* type : std::initializer_list<Type*>{
+           &objectType, &selfType, &boolType, &intType, &stringType, &io}) {
+    namedTypes.insert({type->getAsString(), addType(type)});
   }
-  types.clear();
 }
 
+Type* TypeBuilder::addType(Type* type) {
+  type->id = static_cast<TypeId>(universe.size());
+  universe.push_back(type);
+  return type;
+}
+
+// names which are neither builtin nor classes of the program refer to `Object`
 Type* TypeBuilder::getType(const std::string& typeName) {
-  Type* type{};
-  if (typeName == "Object") {
-    type = &objectType;
-  } else if (typeName == "SELF_TYPE") {
-    type = &selfType;
-  } else if (typeName == "Bool") {
-    type = &boolType;
-  } else if (typeName == "Int") {
-    type = &intType;
-  } else if (typeName == "String") {
-    type = &stringType;
-  } else if (typeName == "IO") {
-    type = &io;
-  } else {
-    assert(inheritanceGraph != nullptr);
-    if (inheritanceGraph->containsNode(typeName)) {
-      const auto it = inheritanceGraph->findNode(typeName);
-      auto* parent = it->second.getParent();
-      assert(parent != nullptr && "parent node is nullptr");
-      auto typeIt = types.find(typeName);
-      if (typeIt != types.end()) {
-        type = typeIt->second;
-      } else {
-        type = new DerivedType(typeName, parent->getNodeName());
-        types[typeName] = type;
-      }
-    } else {
-      type = &objectType;
-    }
+  auto typeIt = namedTypes.find(typeName);
+  if (typeIt != namedTypes.end()) {
+    return typeIt->second;
+  }
+
+  assert(inheritanceGraph != nullptr);
+  const auto it = inheritanceGraph->findNode(typeName);
+  if (it == inheritanceGraph->getNodes().end()) {
+    return &objectType;
   }
 
+  auto* parent = it->second.getParent();
+  assert(parent != nullptr && "parent node is nullptr");
+  ownedTypes.push_back(std::make_unique<DerivedType>(typeName, parent->getNodeName()));
+  auto* type = addType(ownedTypes.back().get());
+  namedTypes.insert({typeName, type});
   return type;
 }
 
 MethodType* TypeBuilder::getMethodType(const std::string& methodName,
                                        Type* methodReturnType,
                                        const std::vector<Type*>& parameterList) {
-  std::stringstream typeNameStream;
-  constexpr char delim{'_'};
-  typeNameStream << "!method" << delim << methodName;
-  typeNameStream << delim << "!params";
+  MethodTypeKey key{methodName, {methodReturnType->getId()}};
   for (auto* param : parameterList) {
-    typeNameStream << delim << param->getAsString();
+    key.signature.push_back(param->getId());
   }
-  typeNameStream << delim << "!return";
-  typeNameStream << delim << methodReturnType->getAsString();
 
-  std::string typeName = typeNameStream.str();
-  auto typeIt = types.find(typeName);
-
-  MethodType* methodType{nullptr};
-  if (typeIt != types.end()) {
-    methodType = dynamic_cast<MethodType*>(typeIt->second);
-    assert(methodType != nullptr);
-  } else {
-    methodType = new MethodType(methodName, methodReturnType, parameterList);
-    types[typeName] = methodType;
+  auto typeIt = methodTypes.find(key);
+  if (typeIt != methodTypes.end()) {
+    return typeIt->second;
   }
 
+  ownedTypes.push_back(std::make_unique<MethodType>(methodName, methodReturnType, parameterList));
+  auto* methodType = static_cast<MethodType*>(addType(ownedTypes.back().get()));
+  methodTypes.insert({std::move(key), methodType});
   return methodType;
 }
-} // namespace mcool::type
\ No newline at end of file
+
+size_t TypeBuilder::MethodTypeKeyHash::operator()(const MethodTypeKey& key) const {
+  auto hash = std::hash<std::string>{}(key.name);
+  for (auto id : key.signature) {
+    hash = (hash * 31) ^ id;
+  }
+  return hash;
+}
+} // namespace mcool::type
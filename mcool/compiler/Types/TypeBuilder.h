@@ -4,21 +4,44 @@
 #include "InheritanceGraph.h"
 #include <unordered_map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace mcool::type {
+// Owns the universe of types. Every type, including method types, is created once and
+// numbered densely, so that types are compared by pointers and tables of types can be
+// indexed by their ids.
 class TypeBuilder {
   public:
-  TypeBuilder() = default;
-  ~TypeBuilder();
+  TypeBuilder();
 
   void setInheritanceGraph(type::Graph* graph) { inheritanceGraph = graph; }
   Type* getType(const std::string& typeName);
+  Type* getType(TypeId id) { return universe[id]; }
   MethodType* getMethodType(const std::string& methodName,
                             Type* methodReturnType,
                             const std::vector<Type*>& parameterList);
+  size_t getNumTypes() const { return universe.size(); }
 
   private:
-  std::unordered_map<std::string, Type*> types;
+  struct MethodTypeKey {
+    std::string name{};
+    // ids of the return type and the parameters
+    std::vector<TypeId> signature{};
+    bool operator==(const MethodTypeKey& other) const {
+      return (name == other.name) && (signature == other.signature);
+    }
+  };
+  struct MethodTypeKeyHash {
+    size_t operator()(const MethodTypeKey& key) const;
+  };
+
+  Type* addType(Type* type);
+
+  std::vector<Type*> universe{};
+  std::vector<std::unique_ptr<Type>> ownedTypes{};
+  std::unordered_map<std::string, Type*> namedTypes{};
+  std::unordered_map<MethodTypeKey, MethodType*, MethodTypeKeyHash> methodTypes{};
 
   ObjectType objectType{};
   SelfType selfType{};
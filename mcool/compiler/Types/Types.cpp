@@ -5,7 +5,8 @@
 namespace mcool::type {
 bool MethodType::isSame(Type* other) {
   assert(other != nullptr);
-  if (auto* otherType = dynamic_cast<MethodType*>(other)) {
+  if (other->getTypeKind() == TypeKind::MethodType) {
+    auto* otherType = static_cast<MethodType*>(other);
     if (this->methodName != otherType->methodName) {
       return false;
     }
@@ -16,7 +17,7 @@ bool MethodType::isSame(Type* other) {
     }
 
     for (size_t i = 0; i < size; ++i) {
-      if (parameters[i]->getAsString() != otherType->parameters[i]->getAsString()) {
+      if (parameters[i] != otherType->parameters[i]) {
         return false;
       }
     }
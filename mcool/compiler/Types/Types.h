@@ -1,12 +1,18 @@
 #pragma once
 
 #include "Misc.h"
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <cassert>
 
 namespace mcool::type {
 enum class TypeKind { Object, SelfType, Bool, Int, String, IO, DerivedType, MethodType };
 
+// dense index of a type within its `TypeBuilder`
+using TypeId = uint32_t;
+
+// Types are unique within a `TypeBuilder`, thus equal types are the same object.
 class Type {
   public:
   virtual ~Type() = default;
@@ -14,7 +20,15 @@ class Type {
   virtual std::string getAsString() = 0;
   virtual TypeKind getTypeKind() = 0;
   virtual bool hasImplicitConstructor() { return false; };
-  virtual bool isSame(Type* other) = 0;
+  virtual bool isSame(Type* other) {
+    assert(other != nullptr);
+    return this == other;
+  }
+  TypeId getId() const { return id; }
+
+  private:
+  friend class TypeBuilder;
+  TypeId id{0};
 };
 
 class BuiltinType : public Type {
@@ -28,10 +42,6 @@ class ObjectType : public BuiltinType {
   ~ObjectType() override = default;
   std::string getAsString() override { return "Object"; }
   TypeKind getTypeKind() override { return TypeKind::Object; }
-  bool isSame(Type* other) final {
-    assert(other != nullptr);
-    return other->getAsString() == "Object";
-  }
 };
 
 class SelfType : public BuiltinType {
@@ -39,10 +49,6 @@ class SelfType : public BuiltinType {
   ~SelfType() override = default;
   std::string getAsString() override { return "SELF_TYPE"; }
   TypeKind getTypeKind() override { return TypeKind::SelfType; }
-  bool isSame(Type* other) final {
-    assert(other != nullptr);
-    return other->getAsString() == "SELF_TYPE";
-  }
 };
 
 class BoolType : public BuiltinType {
@@ -51,10 +57,6 @@ class BoolType : public BuiltinType {
   std::string getAsString() override { return "Bool"; }
   TypeKind getTypeKind() override { return TypeKind::Bool; }
   bool hasImplicitConstructor() final { return true; }
-  bool isSame(Type* other) final {
-    assert(other != nullptr);
-    return other->getAsString() == "Bool";
-  }
 };
 
 class IntType : public BuiltinType {
@@ -63,10 +65,6 @@ class IntType : public BuiltinType {
   std::string getAsString() override { return "Int"; }
   TypeKind getTypeKind() override { return TypeKind::Int; }
   bool hasImplicitConstructor() final { return true; }
-  bool isSame(Type* other) final {
-    assert(other != nullptr);
-    return other->getAsString() == "Int";
-  }
 };
 
 class StringType : public BuiltinType {
@@ -75,10 +73,6 @@ class StringType : public BuiltinType {
   std::string getAsString() override { return "String"; }
   TypeKind getTypeKind() override { return TypeKind::String; }
   bool hasImplicitConstructor() final { return false; }
-  bool isSame(Type* other) final {
-    assert(other != nullptr);
-    return other->getAsString() == "String";
-  }
 };
 
 class IOType : public BuiltinType {
@@ -86,10 +80,6 @@ class IOType : public BuiltinType {
   ~IOType() override = default;
   std::string getAsString() override { return "IO"; }
   TypeKind getTypeKind() override { return TypeKind::IO; }
-  bool isSame(Type* other) final {
-    assert(other != nullptr);
-    return other->getAsString() == "IO";
-  }
 };
 
 class DerivedType : public Type {
@@ -102,15 +92,6 @@ class DerivedType : public Type {
   std::string getAsString() override { return typeName; }
   std::string getParentAsString() { return parentTypeName; }
   TypeKind getTypeKind() override { return TypeKind::DerivedType; }
-  bool isSame(Type* other) final {
-    assert(other != nullptr);
-    if (auto* otherType = dynamic_cast<DerivedType*>(other)) {
-      return otherType->getAsString() == typeName &&
-             otherType->getParentAsString() == parentTypeName;
-    } else {
-      return false;
-    }
-  }
 
   protected:
   std::string typeName{};
@@ -129,6 +110,7 @@ class MethodType : public Type {
   size_t getNumParameters() { return parameters.size(); }
   Type* getReturnType() { return returnType; }
   TypeKind getTypeKind() override { return TypeKind::MethodType; }
+  // methods are the same if they have the same names and parameters
   bool isSame(Type* other) final;
 
   protected:
@@ -2,6 +2,8 @@
 #include "Semant/TypeDriver.h"
 #include "CodeGen/CodeGenDriver.h"
 #include "Misc.h"
+#include "PhaseTimer.h"
+#include "Statistics.h"
 #include "CLI/Error.hpp"
 #include <iostream>
 
@@ -18,8 +20,14 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
+  mcool::misc::PhaseTimer phaseTimer(config);
+  mcool::misc::ScopedPhase compilationPhase("Compilation");
+
   mcool::ParserDriver driver(config);
-  driver.parse();
+  {
+    mcool::misc::ScopedPhase phase("Parsing");
+    driver.parse();
+  }
   auto ast = driver.getAst();
   auto context = driver.getContext();
 
@@ -34,23 +42,46 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
-  mcool::misc::analyseUntypedAst(astTree, config);
+  {
+    mcool::misc::ScopedPhase phase("Untyped AST analysis");
+    mcool::misc::analyseUntypedAst(astTree, config);
+  }
 
-  mcool::AstTree::addBuildinClasses(astTree.get(), &context);
+  {
+    mcool::misc::ScopedPhase phase("Builtin classes");
+    mcool::AstTree::addBuildinClasses(astTree.get(), &context);
+  }
 
   mcool::TypeDriver typeDriver(context, config);
-  auto isTypeCheckingOk = typeDriver.run(astTree);
+  bool isTypeCheckingOk{false};
+  {
+    mcool::misc::ScopedPhase phase("Type checking");
+    isTypeCheckingOk = typeDriver.run(astTree);
+  }
   if (not isTypeCheckingOk) {
     typeDriver.printErrors(std::cerr);
     return -1;
   }
 
   mcool::codegen::CodeGenDriver codeGenDriver(context, config);
-  auto isCodeGenOk = codeGenDriver.run(astTree);
+  bool isCodeGenOk{false};
+  {
+    mcool::misc::ScopedPhase phase("Code generation");
+    isCodeGenOk = codeGenDriver.run(astTree);
+  }
   if (not isCodeGenOk) {
     std::cerr << "code generation failed\n";
     return -1;
   }
 
+  if (config.printStats) {
+    mcool::misc::Statistics statistics{};
+    statistics.addProgram(astTree);
+    statistics.addMemory(context.getMemoryManager());
+    codeGenDriver.collectStatistics(statistics);
+    statistics.addResourceUsage();
+    statistics.print(std::cerr, config.printStatsAsJson);
+  }
+
   return 0;
 }
@@ -5,15 +5,24 @@
 
 namespace ast {
 void AstCodeEmitter::visitRootNode(inheritance::tree::RootNode* node) {
+  bodyStream << "// children of a node are stored contiguously\n";
+  bodyStream << "template <typename Type>\n";
+  bodyStream << "using NodeList = std::vector<Type>;\n\n";
+
   bodyStream << "class StringPtr {\n";
   bodyStream << "public:\n";
-  bodyStream << "  explicit StringPtr(std::string& str) : str(str) {}\n";
+  bodyStream << "  explicit StringPtr(std::string str, uint32_t id = 0)\n";
+  bodyStream << "      : str(std::move(str)), id(id) {}\n";
   bodyStream << "  std::string& get() { return str; }\n";
   bodyStream << "  const std::string& get() const { return str; }\n";
+  bodyStream << "  uint32_t getId() const { return id; }\n";
   bodyStream << "private:\n";
   bodyStream << "  std::string str{};\n";
+  bodyStream << "  uint32_t id{0};\n";
   bodyStream << "};\n\n";
 
+  genNodeKinds(node);
+
   auto className = node->getName();
   bodyStream << "class " << className << " {\n";
   bodyStream << "public:\n";
@@ -31,6 +40,7 @@ void AstCodeEmitter::visitRootNode(inheritance::tree::RootNode* node) {
 
   bodyStream << "  void setSemantType(mcool::type::Type* type) { semantType = type; }\n";
   bodyStream << "  mcool::type::Type* getSemantType() { return semantType; }\n";
+  bodyStream << "  NodeKind getKind() const { return kind; }\n";
 
   ast::genGetters(bodyStream, node->getAttributes());
   ast::genSetters(bodyStream, node->getAttributes());
@@ -38,6 +48,7 @@ void AstCodeEmitter::visitRootNode(inheritance::tree::RootNode* node) {
   genAttributes(node);
   bodyStream << "  mcool::Loc location;\n";
   bodyStream << "  mcool::type::Type* semantType{nullptr};\n";
+  bodyStream << "  NodeKind kind{};\n";
 
   bodyStream << "};\n\n";
 
@@ -58,6 +69,7 @@ void AstCodeEmitter::visitInnerNode(inheritance::tree::InnerNode* node) {
   auto inheritanceChain = getInheritanceChain(node);
   auto constructor = genConstructor(className, inheritanceChain);
   bodyStream << constructor;
+  genClassOf(node);
 
   ast::genGetters(bodyStream, node->getAttributes());
   ast::genSetters(bodyStream, node->getAttributes());
@@ -78,8 +90,9 @@ void AstCodeEmitter::visitLeaf(inheritance::tree::LeafNode* node) {
   bodyStream << "public:\n";
 
   auto inheritanceChain = getInheritanceChain(node);
-  auto constructor = genConstructor(className, inheritanceChain);
+  auto constructor = genConstructor(className, inheritanceChain, "kind = NodeKind::" + className + ";");
   bodyStream << constructor;
+  genClassOf(node);
 
   bodyStream << "  void accept(Visitor* visitor) override { visitor->visit" << node->getName() << "(this); }\n";
   bodyStream << "  const std::string& getClassName() override { return className; }\n";
@@ -103,6 +116,51 @@ void AstCodeEmitter::genAttributes(inheritance::tree::Node* node) {
   bodyStream << "  " << "static const inline std::string className{\"" << node->getName() << "\"};\n";
 }
 
+// leaves are numbered in depth-first order, thus every inner node covers a contiguous range
+// of kinds and `classof` of a class is a single range check
+void AstCodeEmitter::genNodeKinds(inheritance::tree::Node* root) {
+  std::vector<std::string> leaves{};
+  collectLeaves(root, leaves);
+
+  bodyStream << "enum class NodeKind : uint8_t {\n";
+  for (auto& leaf : leaves) {
+    bodyStream << "  " << leaf << ",\n";
+  }
+  for (auto& [className, range] : kindRanges) {
+    bodyStream << "  First" << className << " = " << range.first << ",\n";
+    bodyStream << "  Last" << className << " = " << range.second << ",\n";
+  }
+  bodyStream << "};\n\n";
+}
+
+void AstCodeEmitter::collectLeaves(inheritance::tree::Node* node, std::vector<std::string>& leaves) {
+  if (node->isLeaf()) {
+    leaves.push_back(node->getName());
+    return;
+  }
+
+  auto first = leaves.size();
+  for (auto& child : node->getChildren()) {
+    collectLeaves(child.get(), leaves);
+  }
+  if ((node->getParent() != nullptr) && (leaves.size() > first)) {
+    kindRanges[node->getName()] = std::make_pair(leaves[first], leaves.back());
+  }
+}
+
+void AstCodeEmitter::genClassOf(inheritance::tree::Node* node) {
+  auto className = node->getName();
+  bodyStream << "  static bool classof(const Node* node) { ";
+  if (node->isLeaf()) {
+    bodyStream << "return node->getKind() == NodeKind::" << className << "; }\n";
+  } else if (kindRanges.count(className) != 0) {
+    bodyStream << "return (node->getKind() >= NodeKind::First" << className << ") && ";
+    bodyStream << "(node->getKind() <= NodeKind::Last" << className << "); }\n";
+  } else {
+    bodyStream << "return false; }\n";
+  }
+}
+
 std::vector<inheritance::tree::Node*>
 AstCodeEmitter::getInheritanceChain(inheritance::tree::Node* node) {
   std::vector<inheritance::tree::Node*> nodes{};
@@ -7,6 +7,9 @@
 #include <list>
 #include <tuple>
 #include <sstream>
+#include <map>
+#include <utility>
+#include <vector>
 
 
 namespace ast {
@@ -20,10 +23,16 @@ public:
 
 private:
   void genAttributes(inheritance::tree::Node* node);
+  void genNodeKinds(inheritance::tree::Node* root);
+  void collectLeaves(inheritance::tree::Node* node, std::vector<std::string>& leaves);
+  void genClassOf(inheritance::tree::Node* node);
   std::vector<inheritance::tree::Node*> getInheritanceChain(inheritance::tree::Node* node);
 
   llvm::raw_ostream& OS;
   std::stringstream headerStream;
   std::stringstream bodyStream;
+
+  // the first and the last leaf kinds of every inner node
+  std::map<std::string, std::pair<std::string, std::string>> kindRanges{};
 };
 } // namespace ast::inheritance
\ No newline at end of file
@@ -76,7 +76,7 @@ public:
 
   std::string getName() override {
     auto innerTypeName = innerType->getName();
-    return "std::list<" + innerTypeName + ">";
+    return "NodeList<" + innerTypeName + ">";
   }
 
   Type* getInnerType() {
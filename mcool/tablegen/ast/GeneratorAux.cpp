@@ -2,7 +2,9 @@
 #include "StreamMisc.h"
 
 namespace ast {
-std::string genConstructor(const std::string& className, std::vector<inheritance::tree::Node*>& chain) {
+std::string genConstructor(const std::string& className,
+                           std::vector<inheritance::tree::Node*>& chain,
+                           const std::string& body) {
 
   std::stringstream stream;
 
@@ -13,7 +15,11 @@ std::string genConstructor(const std::string& className, std::vector<inheritance
   if (not initList.empty()) {
     stream << " : " << initList;
   }
-  stream << " {}\n";
+  if (body.empty()) {
+    stream << " {}\n";
+  } else {
+    stream << " { " << body << " }\n";
+  }
   return stream.str();
 }
 
@@ -118,6 +124,9 @@ void genGetters(std::ostream& OS, const std::vector<ast::Attribute*>& attributes
 
       OS << "  const std::string&" << " get" << ast::misc::capitalize(attr->name) << "AsStr";
       OS << "() const { return " << attr->name << "->get(); }\n";
+
+      OS << "  uint32_t get" << ast::misc::capitalize(attr->name) << "Id";
+      OS << "() const { return " << attr->name << "->getId(); }\n";
     }
     else {
       if (attr->type->preferReference()) {
@@ -5,7 +5,9 @@
 #include <ostream>
 
 namespace ast {
-std::string genConstructor(const std::string& className, std::vector<inheritance::tree::Node*>& chain);
+std::string genConstructor(const std::string& className,
+                           std::vector<inheritance::tree::Node*>& chain,
+                           const std::string& body = "");
 std::string genConstructorParameterList(std::vector<inheritance::tree::Node*>& chain);
 std::string genConstructorInitList(std::vector<inheritance::tree::Node*>& chain);
 std::string genConstructorCall(const std::string& className, std::vector<Attribute*>& attrs);
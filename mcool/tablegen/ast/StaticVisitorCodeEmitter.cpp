@@ -0,0 +1,101 @@
+#include "StaticVisitorCodeEmitter.h"
+#include "InheritanceTree.h"
+
+
+namespace ast {
+void StaticVisitorCodeEmitter::visitRootNode(inheritance::tree::RootNode* root) {
+  collectNodeNames(root);
+  for (auto& child : root->getChildren()) {
+    child->accept(this);
+  }
+
+  auto rootName = root->getName();
+  OS << "// Visits nodes without virtual calls: `visit` switches on the kind of a node and calls\n";
+  OS << "// `visit<Kind>` of `Derived`, which visits children of the node by default. A pass\n";
+  OS << "// hides `visit<Kind>` of the nodes it is interested in and may call `visitChildren`.\n";
+  OS << "template <typename Derived>\n";
+  OS << "class RecursiveVisitor {\n";
+  OS << "public:\n";
+  OS << "  void visit(" << rootName << "* node) {\n";
+  OS << "    if (node == nullptr) {\n";
+  OS << "      return;\n";
+  OS << "    }\n";
+  OS << "    switch (node->getKind()) {\n";
+  OS << casesStream.str();
+  OS << "    }\n";
+  OS << "  }\n\n";
+  OS << visitsStream.str() << '\n';
+  OS << childrenStream.str() << '\n';
+  OS << "protected:\n";
+  OS << "  Derived& derived() { return *static_cast<Derived*>(this); }\n";
+  OS << "};\n";
+}
+
+void StaticVisitorCodeEmitter::visitInnerNode(inheritance::tree::InnerNode* node) {
+  for (auto& child : node->getChildren()) {
+    child->accept(this);
+  }
+}
+
+// children are visited in the order of declaration, starting with attributes of parents
+void StaticVisitorCodeEmitter::visitLeaf(inheritance::tree::LeafNode* node) {
+  auto className = node->getName();
+  auto methodName = "visit" + ast::misc::capitalize(className);
+
+  casesStream << "      case NodeKind::" << className << ":\n";
+  casesStream << "        return derived()." << methodName;
+  casesStream << "(static_cast<" << className << "*>(node));\n";
+
+  visitsStream << "  void " << methodName << "(" << className << "* node) { ";
+  visitsStream << "visitChildren(node); }\n";
+
+  std::vector<inheritance::tree::Node*> chain{};
+  for (inheritance::tree::Node* currNode = node; currNode != nullptr;
+       currNode = currNode->getParent()) {
+    chain.insert(chain.begin(), currNode);
+  }
+
+  std::stringstream bodyStream;
+  for (auto* currNode : chain) {
+    for (auto* attr : currNode->getAttributes()) {
+      auto getter = "node->get" + ast::misc::capitalize(attr->name) + "()";
+      auto* type = attr->type.get();
+      if (auto* compositeType = dynamic_cast<ast::Composite*>(type)) {
+        if (not getNodeName(compositeType->getInnerType()).empty()) {
+          bodyStream << "    for (auto* child : " << getter << ") {\n";
+          bodyStream << "      derived().visit(child);\n";
+          bodyStream << "    }\n";
+        }
+      } else if (not getNodeName(type).empty()) {
+        bodyStream << "    derived().visit(" << getter << ");\n";
+      }
+    }
+  }
+
+  auto body = bodyStream.str();
+  if (body.empty()) {
+    childrenStream << "  void visitChildren(" << className << "*) {}\n";
+  } else {
+    childrenStream << "  void visitChildren(" << className << "* node) {\n";
+    childrenStream << body;
+    childrenStream << "  }\n";
+  }
+}
+
+void StaticVisitorCodeEmitter::collectNodeNames(inheritance::tree::Node* node) {
+  nodeNames.insert(node->getName());
+  for (auto& child : node->getChildren()) {
+    collectNodeNames(child.get());
+  }
+}
+
+// returns the class name of a pointer to a node, otherwise an empty string
+std::string StaticVisitorCodeEmitter::getNodeName(ast::Type* type) {
+  if (not type->isPtr()) {
+    return std::string();
+  }
+  auto name = type->getName();
+  name.pop_back();
+  return (nodeNames.count(name) != 0) ? name : std::string();
+}
+} // namespace ast
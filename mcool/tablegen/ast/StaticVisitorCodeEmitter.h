@@ -0,0 +1,30 @@
+#pragma once
+
+#include "InheritanceTreeVisitor.h"
+#include "Misc.h"
+#include "llvm/Support/raw_ostream.h"
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ast {
+class StaticVisitorCodeEmitter : public Visitor {
+public:
+  explicit StaticVisitorCodeEmitter(llvm::raw_ostream& stream) : OS(stream) {}
+
+  void visitRootNode(inheritance::tree::RootNode* root) override;
+  void visitInnerNode(inheritance::tree::InnerNode* node) override;
+  void visitLeaf(inheritance::tree::LeafNode* leaf) override;
+
+private:
+  void collectNodeNames(inheritance::tree::Node* node);
+  std::string getNodeName(ast::Type* type);
+
+  llvm::raw_ostream& OS;
+  std::stringstream casesStream;
+  std::stringstream visitsStream;
+  std::stringstream childrenStream;
+  std::set<std::string> nodeNames{};
+};
+} // namespace ast
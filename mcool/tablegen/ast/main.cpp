@@ -4,6 +4,7 @@
 #include "AstCodeEmitter.h"
 #include "AttributeBuilder.h"
 #include "VisitorCodeEmitter.h"
+#include "StaticVisitorCodeEmitter.h"
 
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/PrettyStackTrace.h"
@@ -17,7 +18,8 @@ enum ActionType {
   PrintRecords,
   PrintInheritanceTree,
   GenAstHeader,
-  GenVisitorHeader
+  GenVisitorHeader,
+  GenStaticVisitorHeader
 };
 
 namespace {
@@ -27,7 +29,8 @@ namespace {
       clEnumValN(PrintRecords, "print-records", "Print all records to stdout (default)"),
       clEnumValN(PrintInheritanceTree, "print-inheritance", "Print inheritance tree"),
       clEnumValN(GenAstHeader, "gen-ast-header", "Generate Ast hpp code"),
-      clEnumValN(GenVisitorHeader, "gen-visitor-header", "Generate Visitor header")
+      clEnumValN(GenVisitorHeader, "gen-visitor-header", "Generate Visitor header"),
+      clEnumValN(GenStaticVisitorHeader, "gen-static-visitor", "Generate RecursiveVisitor header")
     )
   );
 }
@@ -52,6 +55,22 @@ bool generateVisitor(llvm::raw_ostream &OS,
   return false;
 }
 
+bool generateStaticVisitor(llvm::raw_ostream &OS,
+                           std::unique_ptr<ast::inheritance::tree::Node>& tree) {
+  ast::AttributeBuilder builder;
+  tree->accept(&builder);
+
+  OS << "#pragma once\n";
+  OS << "#include \"ast.h\"\n\n";
+  OS << "namespace mcool::ast {\n";
+
+  ast::StaticVisitorCodeEmitter emitter(OS);
+  tree->accept(&emitter);
+
+  OS << "} // namespace mcool::ast\n";
+  return false;
+}
+
 bool generateAstHeader(llvm::raw_ostream &OS,
                        std::unique_ptr<ast::inheritance::tree::Node>& tree) {
 
@@ -62,8 +81,10 @@ bool generateAstHeader(llvm::raw_ostream &OS,
   OS << "#include \"visitor.h\"\n";
   OS << "#include \"Parser/Loc.h\"\n";
   OS << "#include \"Types/Types.h\"\n";
+  OS << "#include <cstdint>\n";
   OS << "#include <string>\n";
-  OS << "#include <list>\n";
+  OS << "#include <utility>\n";
+  OS << "#include <vector>\n";
   OS << "\n\n";
 
   OS << "namespace mcool::ast {\n";
@@ -100,6 +121,9 @@ bool customTableGenMain(llvm::raw_ostream &OS,
     case GenVisitorHeader : {
       return generateVisitor(OS, tree);
     }
+    case GenStaticVisitorHeader : {
+      return generateStaticVisitor(OS, tree);
+    }
     default: {
       llvm::outs() << "no active has been selected\n";
     }
@@ -0,0 +1,135 @@
+#include "auxiliary.h"
+
+namespace {
+using namespace mcool::tests::codegen;
+
+struct Budget {
+  unsigned optLevel;
+  size_t perIteration;
+  size_t fixed;
+};
+
+// Workloads read their number of iterations from stdin. Runs with `n` and `2n` iterations
+// separate allocations per iteration from those done once, e.g. by the entry point.
+void expectAllocations(const std::string& program,
+                       const std::string& expectedOutput,
+                       std::initializer_list<Budget> budgets) {
+  constexpr size_t numIterations{1000};
+  auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+  for (auto& budget : budgets) {
+    SCOPED_TRACE("-O" + std::to_string(budget.optLevel));
+    TestDriver driver(std::string(testInfo->name()) + "-O" + std::to_string(budget.optLevel));
+    ASSERT_TRUE(driver.compile(program, budget.optLevel));
+
+    auto smallRun = driver.run("10\n");
+    ASSERT_TRUE(smallRun.has_value());
+    EXPECT_EQ(smallRun->output, expectedOutput);
+
+    auto firstRun = driver.run(std::to_string(numIterations) + "\n");
+    auto secondRun = driver.run(std::to_string(2 * numIterations) + "\n");
+    ASSERT_TRUE(firstRun.has_value() && secondRun.has_value());
+    ASSERT_GE(secondRun->numAllocations, firstRun->numAllocations);
+
+    auto perIteration = (secondRun->numAllocations - firstRun->numAllocations) / numIterations;
+    auto fixed = firstRun->numAllocations - perIteration * numIterations;
+    EXPECT_LE(perIteration, budget.perIteration);
+    EXPECT_LE(fixed, budget.fixed);
+  }
+}
+} // namespace
+
+// every assignment copies its boxed value
+TEST(Allocations, IntegerLoop) {
+  std::string program{"class Main inherits IO {                   \n"
+                      "  main(): Object {                         \n"
+                      "    let n: Int <- in_int(), i: Int <- 0 in {\n"
+                      "      while i < n loop i <- i + 1 pool;    \n"
+                      "      out_int(i);                          \n"
+                      "    }                                      \n"
+                      "  };                                       \n"
+                      "};                                         \n"};
+  expectAllocations(program, "10", {{0, 1, 6}, {2, 1, 4}});
+}
+
+// temporaries of arithmetic live on the stack
+TEST(Allocations, ArithmeticTemporaries) {
+  std::string program{"class Main inherits IO {                                 \n"
+                      "  main(): Object {                                       \n"
+                      "    let n: Int <- in_int(), i: Int <- 0, sum: Int <- 0 in {\n"
+                      "      while i < n loop {                                 \n"
+                      "        sum <- sum + i * 2 - 1;                          \n"
+                      "        i <- i + 1;                                      \n"
+                      "      } pool;                                            \n"
+                      "      out_int(sum);                                      \n"
+                      "    }                                                    \n"
+                      "  };                                                     \n"
+                      "};                                                       \n"};
+  expectAllocations(program, "80", {{0, 2, 7}, {2, 2, 5}});
+}
+
+TEST(Allocations, LetBindings) {
+  std::string program{"class Main inherits IO {                                      \n"
+                      "  main(): Object {                                            \n"
+                      "    let n: Int <- in_int(), i: Int <- 0, sum: Int <- 0 in {     \n"
+                      "      while i < n loop {                                      \n"
+                      "        let square: Int <- i * i, isEven: Bool <- (i / 2) * 2 = i in\n"
+                      "          if isEven then sum <- sum + square else sum <- sum - square fi;\n"
+                      "        i <- i + 1;                                           \n"
+                      "      } pool;                                                 \n"
+                      "      out_int(sum);                                           \n"
+                      "    }                                                         \n"
+                      "  };                                                          \n"
+                      "};                                                            \n"};
+  expectAllocations(program, "-45", {{0, 4, 7}, {2, 3, 5}});
+}
+
+// arguments and results of methods are copied
+TEST(Allocations, Dispatch) {
+  std::string program{"class Counter {                                                \n"
+                      "  count: Int <- 0;                                             \n"
+                      "  next(step: Int): Int { count <- count + step };              \n"
+                      "};                                                             \n"
+                      "class Main inherits IO {                                       \n"
+                      "  main(): Object {                                             \n"
+                      "    let n: Int <- in_int(), i: Int <- 0, c: Counter <- new Counter in {\n"
+                      "      while i < n loop { c.next(2); i <- i + 1; } pool;        \n"
+                      "      out_int(c.next(0));                                      \n"
+                      "    }                                                          \n"
+                      "  };                                                           \n"
+                      "};                                                             \n"};
+  expectAllocations(program, "20", {{0, 3, 11}, {2, 3, 9}});
+}
+
+TEST(Allocations, NewObjects) {
+  std::string program{"class Point {                                                 \n"
+                      "  x: Int;                                                     \n"
+                      "  y: Int;                                                     \n"
+                      "  init(a: Int, b: Int): Point {{ x <- a; y <- b; self; }};    \n"
+                      "  sum(): Int { x + y };                                       \n"
+                      "};                                                            \n"
+                      "class Main inherits IO {                                      \n"
+                      "  main(): Object {                                            \n"
+                      "    let n: Int <- in_int(), i: Int <- 0, total: Int <- 0 in {   \n"
+                      "      while i < n loop {                                      \n"
+                      "        let p: Point <- new Point in total <- total + p.init(i, 1).sum();\n"
+                      "        i <- i + 1;                                           \n"
+                      "      } pool;                                                 \n"
+                      "      out_int(total);                                         \n"
+                      "    }                                                         \n"
+                      "  };                                                          \n"
+                      "};                                                            \n"};
+  expectAllocations(program, "55", {{0, 10, 7}, {2, 10, 5}});
+}
+
+// a concatenation allocates the characters, the string and its length
+TEST(Allocations, StringConcatenation) {
+  std::string program{"class Main inherits IO {                                   \n"
+                      "  main(): Object {                                         \n"
+                      "    let n: Int <- in_int(), i: Int <- 0, s: String <- \"\" in {\n"
+                      "      while i < n loop { s <- s.concat(\"x\"); i <- i + 1; } pool;\n"
+                      "      out_int(s.length());                                 \n"
+                      "    }                                                      \n"
+                      "  };                                                       \n"
+                      "};                                                         \n"};
+  expectAllocations(program, "10", {{0, 7, 10}, {2, 7, 8}});
+}
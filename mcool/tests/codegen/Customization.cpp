@@ -0,0 +1,66 @@
+#include "auxiliary.h"
+
+namespace {
+using namespace mcool::tests::codegen;
+
+// runs a program built without and with method customization
+void expectSameOutput(const std::string& program, const std::string& expectedOutput) {
+  auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+  for (unsigned optLevel : {0, 2}) {
+    std::optional<std::string> referenceOutput{};
+    for (unsigned budget : {0, 256}) {
+      auto suffix = "-O" + std::to_string(optLevel) + "-budget" + std::to_string(budget);
+      SCOPED_TRACE(suffix);
+      mcool::misc::Config config{};
+      config.optLevel = optLevel;
+      config.customizationBudget = budget;
+      TestDriver driver(std::string(testInfo->name()) + suffix);
+      ASSERT_TRUE(driver.compile(program, config));
+
+      auto result = driver.run("");
+      ASSERT_TRUE(result.has_value());
+      if (referenceOutput) {
+        EXPECT_EQ(result->output, referenceOutput.value());
+      } else {
+        referenceOutput = result->output;
+      }
+      EXPECT_EQ(result->output, expectedOutput);
+    }
+  }
+}
+} // namespace
+
+// `describe` is cloned into `B` and `C`, where its dispatches on `self` become direct calls;
+// static dispatches must still reach the implementation of the named class
+TEST(Customization, OverridingAndStaticDispatch) {
+  std::string program{"class A inherits IO {                                     \n"
+                      "  name(): String { \"A\" };                               \n"
+                      "  depth(): Int { 1 };                                     \n"
+                      "  describe(): Object {                                    \n"
+                      "    {                                                     \n"
+                      "      out_string(name());                                 \n"
+                      "      out_string(self.name());                            \n"
+                      "      out_int(depth());                                   \n"
+                      "    }                                                     \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"
+                      "class B inherits A {                                      \n"
+                      "  name(): String { \"B\" };                               \n"
+                      "  depth(): Int { 1 + self@A.depth() };                    \n"
+                      "};                                                        \n"
+                      "class C inherits B {                                      \n"
+                      "  depth(): Int { 1 + self@B.depth() };                    \n"
+                      "};                                                        \n"
+                      "class Main inherits IO {                                  \n"
+                      "  main(): Object {                                        \n"
+                      "    {                                                     \n"
+                      "      (new A).describe();                                 \n"
+                      "      (new B).describe();                                 \n"
+                      "      (new C).describe();                                 \n"
+                      "      (new C)@A.describe();                               \n"
+                      "      out_string((new C)@A.name());                       \n"
+                      "    }                                                     \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  expectSameOutput(program, "AA1BB2BB3BB3A");
+}
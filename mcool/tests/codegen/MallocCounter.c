@@ -0,0 +1,18 @@
+// Counts calls of `malloc` made by generated code. Programs are linked with
+// `-Wl,--wrap=malloc`, which redirects only the references of the program itself,
+// thus allocations inside libc, e.g. of stdio buffers, are not counted.
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned long numAllocations = 0;
+
+void* __real_malloc(size_t size);
+
+void* __wrap_malloc(size_t size) {
+  ++numAllocations;
+  return __real_malloc(size);
+}
+
+__attribute__((destructor)) static void reportAllocations(void) {
+  fprintf(stderr, "%lu\n", numAllocations);
+}
@@ -0,0 +1,86 @@
+#include "auxiliary.h"
+
+namespace {
+using namespace mcool::tests::codegen;
+
+void expectOutput(const std::string& program, const std::string& expectedOutput) {
+  auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+  for (unsigned optLevel : {0, 2}) {
+    SCOPED_TRACE("-O" + std::to_string(optLevel));
+    TestDriver driver(std::string(testInfo->name()) + "-O" + std::to_string(optLevel));
+    ASSERT_TRUE(driver.compile(program, optLevel));
+
+    auto result = driver.run("");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->output, expectedOutput);
+  }
+}
+} // namespace
+
+// `=` and `<` used to fall through to `<=`
+TEST(Miscompiles, IntegerComparisons) {
+  std::string program{"class Main inherits IO {                                  \n"
+                      "  print(value: Bool): Object {                            \n"
+                      "    out_string(if value then \"t\" else \"f\" fi)         \n"
+                      "  };                                                      \n"
+                      "  main(): Object {                                        \n"
+                      "    let two: Int <- 2, three: Int <- 3 in {               \n"
+                      "      print(two = three);                                 \n"
+                      "      print(two = two);                                   \n"
+                      "      print(two < two);                                   \n"
+                      "      print(two < three);                                 \n"
+                      "      print(three <= two);                                \n"
+                      "      print(two <= two);                                  \n"
+                      "    }                                                     \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  expectOutput(program, "ftftft");
+}
+
+// the back edge of a loop used to skip all but the last block of its predicate
+TEST(Miscompiles, WhileLoopWithBranchingPredicate) {
+  std::string program{"class Main inherits IO {                                  \n"
+                      "  main(): Object {                                        \n"
+                      "    let i: Int <- 0 in {                                  \n"
+                      "      while if i < 3 then true else false fi loop         \n"
+                      "        i <- i + 1                                        \n"
+                      "      pool;                                               \n"
+                      "      out_int(i);                                         \n"
+                      "    }                                                     \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  expectOutput(program, "3");
+}
+
+// concat used to store its length into the Int shared with the prototype of String
+TEST(Miscompiles, StringConcat) {
+  std::string program{"class Main inherits IO {                                  \n"
+                      "  main(): Object {                                        \n"
+                      "    let first: String <- \"ab\".concat(\"c\"),            \n"
+                      "        second: String <- \"defg\".concat(\"hi\") in {    \n"
+                      "      out_string(first.concat(second));                   \n"
+                      "      out_int(first.length());                            \n"
+                      "      out_int(second.length());                           \n"
+                      "      out_int((new String).length());                     \n"
+                      "    }                                                     \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  expectOutput(program, "abcdefghi360");
+}
+
+// methods which only return a formal were summarized as `readnone`, thus at -O2 the stores
+// which initialize a literal argument were deleted before the callee copied it
+TEST(Miscompiles, IdentityOfLiteral) {
+  std::string program{"class Main inherits IO {                                  \n"
+                      "  id(x: Int): Int { x };                                  \n"
+                      "  name(s: String): String { s };                          \n"
+                      "  main(): Object {                                        \n"
+                      "    {                                                     \n"
+                      "      out_int(id(42));                                    \n"
+                      "      out_string(name(\"abc\"));                          \n"
+                      "      out_int(let y: Int <- 7 in id(y));                  \n"
+                      "    }                                                     \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  expectOutput(program, "42abc7");
+}
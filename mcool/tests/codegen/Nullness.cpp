@@ -0,0 +1,111 @@
+#include "auxiliary.h"
+
+namespace {
+using namespace mcool::tests::codegen;
+
+const std::string nullptrDiagnostic{"Operating on nullptr. Aborting.\n"};
+
+void expectAbort(const std::string& program, const std::string& expectedOutput) {
+  auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+  for (unsigned optLevel : {0, 2}) {
+    SCOPED_TRACE("-O" + std::to_string(optLevel));
+    TestDriver driver(std::string(testInfo->name()) + "-O" + std::to_string(optLevel));
+    ASSERT_TRUE(driver.compile(program, optLevel));
+
+    auto result = driver.runToExit("");
+    EXPECT_NE(result.exitStatus, 0);
+    EXPECT_EQ(result.output, expectedOutput);
+  }
+}
+
+bool hasNullCheck(const std::string& functionIr) {
+  return functionIr.find("@_abort_on_nullptr()") != std::string::npos;
+}
+} // namespace
+
+TEST(Nullness, VoidAttributeReceiver) {
+  std::string program{"class Node { value(): Int { 1 }; };                       \n"
+                      "class Main inherits IO {                                  \n"
+                      "  node: Node;                                             \n"
+                      "  main(): Object {                                        \n"
+                      "    {                                                     \n"
+                      "      out_string(\"before\\n\");                          \n"
+                      "      out_int(node.value());                              \n"
+                      "    }                                                     \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  expectAbort(program, "before\n" + nullptrDiagnostic);
+}
+
+TEST(Nullness, VoidLocalReceiver) {
+  std::string program{"class Node { value(): Int { 1 }; };                       \n"
+                      "class Main inherits IO {                                  \n"
+                      "  main(): Object {                                        \n"
+                      "    let node: Node in out_int(node.value())               \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  expectAbort(program, nullptrDiagnostic);
+}
+
+// the body of a loop is analyzed with the state at its entry, where `node` is still void
+TEST(Nullness, ReassignedInLoop) {
+  std::string program{"class Node { value(): Int { 1 }; };                       \n"
+                      "class Main inherits IO {                                  \n"
+                      "  main(): Object {                                        \n"
+                      "    let node: Node, i: Int <- 0 in                        \n"
+                      "      while i < 2 loop {                                  \n"
+                      "        out_int(node.value());                            \n"
+                      "        node <- new Node;                                 \n"
+                      "        i <- i + 1;                                       \n"
+                      "      } pool                                              \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  expectAbort(program, nullptrDiagnostic);
+
+  TestDriver driver("ReassignedInLoop-ir");
+  mcool::misc::Config config{};
+  config.emitLLVMIr = true;
+  ASSERT_TRUE(driver.compile(program, config));
+  EXPECT_TRUE(hasNullCheck(driver.getFunctionIr("Main_main")));
+}
+
+TEST(Nullness, ElidedChecks) {
+  std::string program{"class Node { value(): Int { 1 }; };                       \n"
+                      "class Main inherits IO {                                  \n"
+                      "  guarded(x: Node): Int {                                 \n"
+                      "    if isvoid x then 0 else x.value() fi                  \n"
+                      "  };                                                      \n"
+                      "  negated(x: Node): Int {                                 \n"
+                      "    if not isvoid x then x.value() else 0 fi              \n"
+                      "  };                                                      \n"
+                      "  fresh(): Int { (new Node).value() };                    \n"
+                      "  itself(): Int { self.two() + two() - 2 };               \n"
+                      "  two(): Int { 2 };                                       \n"
+                      "  unguarded(x: Node): Int { x.value() };                  \n"
+                      "  main(): Object {                                        \n"
+                      "    {                                                     \n"
+                      "      out_int(guarded(new Node));                         \n"
+                      "      out_int(negated(new Node));                         \n"
+                      "      out_int(fresh());                                   \n"
+                      "      out_int(itself());                                  \n"
+                      "      out_int(unguarded(new Node));                       \n"
+                      "    }                                                     \n"
+                      "  };                                                      \n"
+                      "};                                                        \n"};
+  TestDriver driver("ElidedChecks");
+  mcool::misc::Config config{};
+  config.emitLLVMIr = true;
+  ASSERT_TRUE(driver.compile(program, config));
+
+  auto result = driver.run("");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->output, "11121");
+
+  for (auto* method : {"Main_guarded", "Main_negated", "Main_fresh", "Main_itself"}) {
+    SCOPED_TRACE(method);
+    auto functionIr = driver.getFunctionIr(method);
+    ASSERT_FALSE(functionIr.empty());
+    EXPECT_FALSE(hasNullCheck(functionIr));
+  }
+  EXPECT_TRUE(hasNullCheck(driver.getFunctionIr("Main_unguarded")));
+}
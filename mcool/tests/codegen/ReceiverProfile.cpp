@@ -0,0 +1,68 @@
+#include "auxiliary.h"
+
+namespace {
+using namespace mcool::tests::codegen;
+
+const std::string dispatchProgram{"class A { f(): Int { 1 }; };                              \n"
+                                  "class B inherits A { f(): Int { 2 }; };                   \n"
+                                  "class C inherits B { f(): Int { 3 }; };                   \n"
+                                  "class Main inherits IO {                                  \n"
+                                  "  pick(n: Int): A {                                       \n"
+                                  "    if n = 0 then new A else                              \n"
+                                  "      if n = 1 then new B else new C fi                   \n"
+                                  "    fi                                                    \n"
+                                  "  };                                                      \n"
+                                  "  main(): Object {                                        \n"
+                                  "    let n: Int <- in_int(), i: Int <- 0, sum: Int <- 0 in {\n"
+                                  "      while i < 10 loop {                                 \n"
+                                  "        sum <- sum + pick(n).f();                         \n"
+                                  "        i <- i + 1;                                       \n"
+                                  "      } pool;                                             \n"
+                                  "      out_int(sum);                                       \n"
+                                  "    }                                                     \n"
+                                  "  };                                                      \n"
+                                  "};                                                        \n"};
+} // namespace
+
+// the profile only records `A` receivers, thus `B` and `C` take the virtual dispatch left
+// behind the guard; records of removed sites and classes must not break the build
+TEST(ReceiverProfile, RoundTrip) {
+  TestDriver plainDriver("RoundTrip-plain");
+  mcool::misc::Config plainConfig{};
+  plainConfig.emitLLVMIr = true;
+  ASSERT_TRUE(plainDriver.compile(dispatchProgram, plainConfig));
+  EXPECT_EQ(plainDriver.getFunctionIr("Main_main").find("@A_f("), std::string::npos);
+
+  TestDriver generateDriver("RoundTrip-generate");
+  auto profileFile = generateDriver.getBasePath() + ".prof";
+  std::filesystem::remove(profileFile);
+  generateDriver.setLinker("clang -no-pie -fprofile-generate");
+  mcool::misc::Config generateConfig{};
+  generateConfig.profileGenerateFile = profileFile;
+  ASSERT_TRUE(generateDriver.compile(dispatchProgram, generateConfig));
+
+  auto trainingRun = generateDriver.run("0\n");
+  ASSERT_TRUE(trainingRun.has_value());
+  EXPECT_EQ(trainingRun->output, "10");
+  ASSERT_TRUE(std::filesystem::exists(profileFile));
+
+  std::ofstream(profileFile, std::ios::app) << "# stale records\n"
+                                            << "Main_removed#0 A 50\n"
+                                            << "Main_main#99 Ghost 7\n";
+
+  TestDriver useDriver("RoundTrip-use");
+  mcool::misc::Config useConfig{};
+  useConfig.profileUseFile = profileFile;
+  useConfig.emitLLVMIr = true;
+  ASSERT_TRUE(useDriver.compile(dispatchProgram, useConfig));
+  EXPECT_NE(useDriver.getFunctionIr("Main_main").find("@A_f("), std::string::npos);
+
+  for (auto* input : {"0\n", "1\n", "2\n"}) {
+    SCOPED_TRACE(input);
+    auto expected = plainDriver.run(input);
+    auto result = useDriver.run(input);
+    ASSERT_TRUE(expected.has_value());
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->output, expected->output);
+  }
+}
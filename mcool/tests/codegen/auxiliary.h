@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Parser/Scanner.h"
+#include "Parser.h"
+#include "Context.h"
+#include "Misc.h"
+#include "Semant/TypeDriver.h"
+#include "CodeGen/CodeGenDriver.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+
+namespace mcool::tests::codegen {
+struct RunResult {
+  std::string output{};
+  size_t numAllocations{0};
+  int exitStatus{0};
+};
+
+// Compiles a program in memory, links it with the malloc counter and runs it
+class TestDriver {
+  public:
+  explicit TestDriver(const std::string& name) {
+    auto directory = std::filesystem::temp_directory_path() / "mcool-codegen-tests";
+    std::filesystem::create_directories(directory);
+    basePath = (directory / name).string();
+  }
+
+  bool compile(const std::string& program, unsigned optLevel) {
+    mcool::misc::Config config{};
+    config.optLevel = optLevel;
+    return compile(program, config);
+  }
+
+  // the input and output files of `config` are set by the driver
+  bool compile(const std::string& program, mcool::misc::Config config) {
+    config.inputFiles = {inputFileName};
+    config.outputFile = basePath;
+
+    mcool::Context context{};
+    mcool::AstTree astTree{};
+    std::istringstream stream(program);
+    mcool::Scanner scanner(true);
+    mcool::Parser parser(scanner, astTree, context.getMemoryManager());
+    scanner.set(&stream, &inputFileName);
+    if (parser.parse() != 0) {
+      return false;
+    }
+
+    mcool::AstTree::addBuildinClasses(astTree.get(), &context);
+    mcool::TypeDriver typeDriver(context, config);
+    if (not typeDriver.run(astTree)) {
+      typeDriver.printErrors(std::cerr);
+      return false;
+    }
+
+    mcool::codegen::CodeGenDriver codeGenDriver(context, config);
+    if (not codeGenDriver.run(astTree)) {
+      return false;
+    }
+
+    auto link = linker + " -Wl,--wrap=malloc " + basePath + ".o " + MALLOC_COUNTER_OBJECT +
+                " -o " + basePath;
+    return std::system(link.c_str()) == 0;
+  }
+
+  // e.g. `clang -no-pie -fprofile-generate` for programs instrumented with an llvm ir profile
+  void setLinker(const std::string& command) { linker = command; }
+
+  const std::string& getBasePath() const { return basePath; }
+
+  std::optional<RunResult> run(const std::string& input) {
+    auto result = runToExit(input);
+    if (result.exitStatus != 0) {
+      return std::nullopt;
+    }
+    return result;
+  }
+
+  // also returns the output of programs which exit with an error, e.g. on a void receiver
+  RunResult runToExit(const std::string& input) {
+    std::ofstream(basePath + ".in") << input;
+    auto command = basePath + " < " + basePath + ".in > " + basePath + ".out 2> " + basePath +
+                   ".allocations";
+    auto status = std::system(command.c_str());
+
+    RunResult result{};
+    result.exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    result.output = readFile(basePath + ".out");
+    std::ifstream(basePath + ".allocations") >> result.numAllocations;
+    return result;
+  }
+
+  // the body of a function in the llvm ir written with `emitLLVMIr`
+  std::string getFunctionIr(const std::string& functionName) {
+    auto ir = readFile(basePath + ".ll");
+    auto symbol = "@" + functionName + "(";
+    for (auto begin = ir.find("\ndefine "); begin != std::string::npos;
+         begin = ir.find("\ndefine ", begin + 1)) {
+      auto header = ir.substr(begin, ir.find('\n', begin + 1) - begin);
+      if (header.find(symbol) != std::string::npos) {
+        auto end = ir.find("\n}\n", begin);
+        return ir.substr(begin, (end != std::string::npos) ? end - begin : std::string::npos);
+      }
+    }
+    return "";
+  }
+
+  private:
+  static std::string readFile(const std::string& fileName) {
+    std::ifstream stream(fileName);
+    std::stringstream content;
+    content << stream.rdbuf();
+    return content.str();
+  }
+
+  std::string inputFileName{"test-stream"};
+  std::string basePath{};
+  std::string linker{"cc -no-pie"};
+};
+} // namespace mcool::tests::codegen
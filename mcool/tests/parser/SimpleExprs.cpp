@@ -1,5 +1,6 @@
 #include "auxiliary.h"
 #include "TestParserVisitor.h"
+#include "llvm/Support/Casting.h"
 #include <iostream>
 
 TEST(SimpleExpressions, SingleSimpleExpr) {
@@ -18,6 +19,39 @@ TEST(SimpleExpressions, SingleSimpleExpr) {
   ASSERT_EQ(boolExpr->getValue(), true);
 }
 
+TEST(SimpleExpressions, NodeKinds) {
+  std::stringstream stream;
+  stream << "class A {\n"
+         << "  x : Int;\n"
+         << "  main() : Object { x + 1 };\n"
+         << "};\n";
+
+  mcool::ast::SingleMethod* method{nullptr};
+  mcool::tests::AttrExtractor extractor(stream);
+  extractor.getAttr(method, 0, 1);
+
+  mcool::ast::Node* body = method->getBody();
+  ASSERT_EQ(body->getKind(), mcool::ast::NodeKind::PlusNode);
+  ASSERT_TRUE(llvm::isa<mcool::ast::PlusNode>(body));
+  ASSERT_TRUE(llvm::isa<mcool::ast::BinaryExpression>(body));
+  ASSERT_TRUE(llvm::isa<mcool::ast::Expression>(body));
+  ASSERT_TRUE(llvm::isa<mcool::ast::NonTerminal>(body));
+  ASSERT_FALSE(llvm::isa<mcool::ast::MinusNode>(body));
+  ASSERT_FALSE(llvm::isa<mcool::ast::UnaryExpression>(body));
+  ASSERT_FALSE(llvm::isa<mcool::ast::Terminal>(body));
+
+  auto* plus = llvm::cast<mcool::ast::PlusNode>(body);
+  auto* right = llvm::dyn_cast<mcool::ast::PrimaryExpr>(plus->getRight());
+  ASSERT_TRUE(right != nullptr);
+  ASSERT_TRUE(llvm::isa<mcool::ast::Int>(right->getTerm()));
+  ASSERT_TRUE(llvm::isa<mcool::ast::Terminal>(right->getTerm()));
+  ASSERT_TRUE(llvm::dyn_cast<mcool::ast::String>(right->getTerm()) == nullptr);
+
+  mcool::ast::Node* attr = method;
+  ASSERT_TRUE(llvm::isa<mcool::ast::ClassAttribute>(attr));
+  ASSERT_FALSE(llvm::isa<mcool::ast::SingleMember>(attr));
+}
+
 TEST(SimpleExpressions, Block) {
   std::stringstream stream;
   stream << "class A {\n"
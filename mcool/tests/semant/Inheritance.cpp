@@ -157,4 +157,45 @@ TEST(Inheritance, childParent) {
   ASSERT_TRUE(integer.isChildOf(&object));
   ASSERT_FALSE(object.isChildOf(&integer));
   ASSERT_FALSE(integer.isChildOf(&boolean));
-}
\ No newline at end of file
+}
+
+TEST(Inheritance, commonParent) {
+  std::stringstream stream;
+  stream << "class ClassA {};               \n"
+         << "class ClassB inherits ClassA {};\n"
+         << "class ClassC inherits ClassB {};\n"
+         << "class ClassD inherits ClassA {};\n"
+         << "class ClassE inherits ClassD {};\n"
+         << "class ClassF {};               \n";
+
+  mcool::tests::semant::TestDriver driver(stream);
+  auto [status, ast] = driver.run();
+
+  ASSERT_THAT(status, true);
+  ASSERT_THAT(ast.isAstOk(), true);
+
+  mcool::semant::InheritanceGraphBuilder graphBuilder;
+  auto graph = graphBuilder.build(ast.get());
+
+  ASSERT_FALSE(graphBuilder.hasErrors());
+
+  auto& nodes = graph->getNodes();
+  const auto& classA = nodes.find("ClassA")->second;
+  const auto& classB = nodes.find("ClassB")->second;
+  const auto& classC = nodes.find("ClassC")->second;
+  const auto& classE = nodes.find("ClassE")->second;
+  const auto& classF = nodes.find("ClassF")->second;
+  const auto& object = nodes.find("Object")->second;
+
+  ASSERT_TRUE(classC.hasIndex());
+  ASSERT_EQ(classC.getDepth(), classA.getDepth() + 2);
+
+  ASSERT_EQ(mcool::type::findCommonParentType(&classC, &classE), &classA);
+  ASSERT_EQ(mcool::type::findCommonParentType(&classE, &classC), &classA);
+  ASSERT_EQ(mcool::type::findCommonParentType(&classC, &classB), &classB);
+  ASSERT_EQ(mcool::type::findCommonParentType(&classC, &classC), &classC);
+  ASSERT_EQ(mcool::type::findCommonParentType(&classC, &classF), &object);
+
+  ASSERT_TRUE(classC.isChildOf(&classA));
+  ASSERT_FALSE(classE.isChildOf(&classB));
+}